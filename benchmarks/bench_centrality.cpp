@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+
+#include "algorithm/centrality.hpp"
+#include "bench_util.hpp"
+
+/*
+ * Betweenness centrality of a random sparse graph: exact Brandes on 1 and all
+ * hardware threads, then source sampling of decreasing size with the largest
+ * relative error on the ten most central nodes.
+ */
+
+static constexpr std::size_t NODE_NUM = 4000;
+static constexpr std::size_t DEGREE = 4;
+static constexpr std::size_t TOP_NUM = 10;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node, xgraph::EmptyObject, void>;
+
+int main() {
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937_64 rng(42);
+  for (std::size_t i = 0; i < NODE_NUM * DEGREE; ++i) {
+    const auto s = rng() % NODE_NUM;
+    const auto t = rng() % NODE_NUM;
+    if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+      graph.AddEdge(s, t);
+    }
+  }
+  const xgraph::CSRGraph csr(graph);
+
+  std::printf("%-16s %12s %16s\n", "mode", "time (ms)", "top max error");
+
+  std::vector<double> exact;
+  const auto threads = xgraph::utils::WorkerCount(0);
+  for (const auto t : {std::size_t{1}, threads}) {
+    const auto ms =
+        Millis([&] { exact = xgraph::algorithm::Betweenness(csr, 0, t); });
+    std::printf("exact x%-9zu %12.2f %16.4f\n", t, ms, 0.0);
+  }
+
+  std::vector<std::size_t> top(NODE_NUM);
+  std::iota(top.begin(), top.end(), 0);
+  std::ranges::partial_sort(top, top.begin() + TOP_NUM,
+                            [&exact](const auto a, const auto b) {
+                              return exact[a] > exact[b];
+                            });
+  top.resize(TOP_NUM);
+
+  for (const auto samples : {NODE_NUM / 4, NODE_NUM / 16, NODE_NUM / 64}) {
+    std::vector<double> approx;
+    const auto ms = Millis([&] {
+      approx = xgraph::algorithm::Betweenness(csr, samples, threads, 7);
+    });
+    double error{0.0};
+    for (const auto v : top) {
+      error = std::max(error, std::abs(approx[v] - exact[v]) / exact[v]);
+    }
+    std::printf("sample %-9zu %12.2f %16.4f\n", samples, ms, error);
+  }
+
+  return 0;
+}
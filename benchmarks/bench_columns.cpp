@@ -0,0 +1,58 @@
+#include <cstdio>
+#include <random>
+#include <utility>
+
+#include "bench_util.hpp"
+#include "structure/csr.hpp"
+
+/*
+ * Sum of an edge attribute over all edges: through the edge pointers of the
+ * graph against a column extracted from a `CSRGraph`.
+ */
+
+static constexpr std::size_t NODE_NUM = 1 << 14;
+static constexpr std::size_t EDGE_NUM = 1 << 20;
+static constexpr int REPEAT = 20;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node, long>;
+
+int main() {
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937_64 rng(42);
+  for (std::size_t i = 0; i < EDGE_NUM; ++i) {
+    graph.AddEdge(rng() % NODE_NUM, rng() % NODE_NUM, 1.0,
+                  static_cast<long>(i % 7));
+  }
+
+  const xgraph::CSRGraph csr(graph);
+  const auto column = csr.EdgeColumn([](const Edge& e) { return e.Data(); });
+
+  long pointer_sum{0};
+  const auto edges = graph.Edges();
+  const auto pointer_ms = Millis([&] {
+    for (int r = 0; r < REPEAT; ++r) {
+      for (const auto& e : edges) {
+        pointer_sum += std::as_const(*e).Data();
+      }
+    }
+  });
+
+  long column_sum{0};
+  const auto column_ms = Millis([&] {
+    for (int r = 0; r < REPEAT; ++r) {
+      for (const auto value : column) {
+        column_sum += value;
+      }
+    }
+  });
+
+  std::printf("%-10s %12s %16s\n", "layout", "time (ms)", "sum");
+  std::printf("%-10s %12.2f %16ld\n", "pointers", pointer_ms, pointer_sum);
+  std::printf("%-10s %12.2f %16ld\n", "column", column_ms, column_sum);
+
+  return 0;
+}
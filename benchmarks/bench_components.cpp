@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#include "algorithm/components.hpp"
+#include "bench_util.hpp"
+
+/*
+ * Strongly connected components of a sparse random digraph with a giant
+ * component and many trimmable nodes: iterative Pearce against parallel
+ * forward-backward on 1 and all hardware threads, then the condensation.
+ */
+
+static constexpr std::size_t NODE_NUM = 200000;
+static constexpr std::size_t EDGE_NUM = 300000;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node>;
+
+int main() {
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937_64 rng(42);
+  for (std::size_t k = 0; k < EDGE_NUM; ++k) {
+    const auto s = rng() % NODE_NUM;
+    const auto t = rng() % NODE_NUM;
+    if (!graph.GetEdge(s, t, std::nullopt)) {
+      graph.AddEdge(s, t);
+    }
+  }
+  const xgraph::CSRGraph csr(graph);
+
+  std::printf("%-16s %12s %16s\n", "mode", "time (ms)", "components");
+
+  std::vector<std::size_t> component;
+  const auto pearce_ms = Millis([&] {
+    component = xgraph::algorithm::StronglyConnectedComponents(csr);
+  });
+  std::printf("%-16s %12.2f %16zu\n", "Pearce", pearce_ms,
+              std::ranges::max(component) + 1);
+
+  const auto threads = xgraph::utils::WorkerCount(0);
+  for (const auto t : {std::size_t{1}, threads}) {
+    const auto ms = Millis([&] {
+      component =
+          xgraph::algorithm::ParallelStronglyConnectedComponents(csr, t);
+    });
+    std::printf("FW-BW x%-9zu %12.2f %16zu\n", t, ms,
+                std::ranges::max(component) + 1);
+  }
+
+  std::size_t edges{0};
+  const auto dag_ms = Millis([&] {
+    edges = xgraph::algorithm::Condensation(csr, component).EdgeSize();
+  });
+  std::printf("%-16s %12.2f %16zu edges\n", "condensation", dag_ms, edges);
+
+  return 0;
+}
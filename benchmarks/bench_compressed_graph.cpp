@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <random>
+#include <tuple>
+
+#include "algorithm/traversal.hpp"
+#include "bench_util.hpp"
+#include "structure/compressed_graph.hpp"
+
+/*
+ * Memory per arc and decode throughput of `CompressedGraph` against the
+ * `CSRGraph` it is built from. The graph is made of communities of
+ * consecutive ids, so gaps are mostly small and neighborhoods overlap.
+ */
+
+static constexpr std::size_t NODE_NUM = 1 << 17;
+static constexpr std::size_t COMMUNITY = 256;
+static constexpr std::size_t DEGREE = 16;
+static constexpr int REPEAT = 10;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node, xgraph::EmptyObject, void>;
+
+template <typename Graph> static std::size_t Scan(const Graph& graph) {
+  std::size_t sum{0};
+  for (std::size_t i = 0; i < graph.NodeSize(); ++i) {
+    for (const auto t : graph.OutNeighbors(i)) {
+      sum += t;
+    }
+  }
+  return sum;
+}
+
+template <typename Graph>
+static void Report(const char* name, const Graph& graph,
+                   const std::size_t bytes) {
+  std::size_t sum{0};
+  const auto scan_ms = Millis([&] {
+    for (int r = 0; r < REPEAT; ++r) {
+      sum += Scan(graph);
+    }
+  });
+  const auto arcs = static_cast<double>(graph.EdgeSize()) * REPEAT;
+  std::printf("%-16s %12.2f %14.1f %16zu\n", name,
+              static_cast<double>(bytes) /
+                  static_cast<double>(graph.EdgeSize()),
+              arcs / scan_ms / 1e3, sum);
+}
+
+int main() {
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937_64 rng(42);
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    const auto base = i / COMMUNITY * COMMUNITY;
+    for (std::size_t k = 0; k < DEGREE; ++k) {
+      const auto j = rng() % 32 == 0 ? rng() % NODE_NUM
+                                     : base + rng() % COMMUNITY;
+      graph.AddEdge(i, j);
+    }
+  }
+
+  const xgraph::CSRGraph csr(graph);
+  std::printf("%-16s %12s %14s %16s\n", "layout", "bytes / arc",
+              "Marcs / s", "checksum");
+  // Targets, edge pointers, in rows and offsets
+  const auto csr_bytes =
+      csr.EdgeSize() * (2 * sizeof(std::size_t) + sizeof(csr.OutEdges(0)[0])) +
+      2 * (csr.NodeSize() + 1) * sizeof(std::size_t);
+  Report("csr", csr, csr_bytes);
+
+  using xgraph::AdjacencyCodec;
+  const std::tuple<const char*, AdjacencyCodec, std::size_t> layouts[] = {
+      {"varint", AdjacencyCodec::Varint, 0},
+      {"streamvbyte", AdjacencyCodec::StreamVByte, 0},
+      {"varint+ref", AdjacencyCodec::Varint, 7},
+      {"streamvbyte+ref", AdjacencyCodec::StreamVByte, 7},
+  };
+  for (const auto& [name, codec, window] : layouts) {
+    const xgraph::CompressedGraph compressed(csr, codec, window);
+    Report(name, compressed, compressed.ByteSize());
+  }
+
+  // Traversal directly on the compressed lists
+  const xgraph::CompressedGraph compressed(csr);
+  std::size_t visited{0};
+  const std::optional<xgraph::NodePtrVisitor_t<Node>> count =
+      [&visited](const std::shared_ptr<Node>&) { ++visited; };
+  const auto bfs_ms = Millis([&] {
+    xgraph::algorithm::BFS(compressed, graph.GetNode(0), count);
+  });
+  std::printf("bfs on varint: %zu nodes in %.2f ms\n", visited, bfs_ms);
+
+  return 0;
+}
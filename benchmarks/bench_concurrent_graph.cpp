@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "structure/concurrent_graph.hpp"
+#include "structure/graph.hpp"
+
+/*
+ * Read throughput of `ConcurrentDiGraph` against a `DiGraph` guarded by one
+ * global `std::shared_mutex`, while writer threads keep adding edges.
+ */
+
+static constexpr std::size_t NODE_NUM = 1 << 14;
+static constexpr std::size_t WRITER_NUM = 2;
+static constexpr auto DURATION = std::chrono::milliseconds(500);
+
+//! @brief Keeps reads observable
+static std::atomic<std::size_t> checksum{0};
+
+/*!
+ * @brief `DiGraph` behind a global reader-writer lock
+ */
+class LockedDiGraph {
+public:
+  void AddNode(const std::size_t id) {
+    std::unique_lock lock(mutex);
+    graph.AddNode(id);
+  }
+
+  void AddEdge(const std::size_t s, const std::size_t t) {
+    std::unique_lock lock(mutex);
+    graph.AddEdge(s, t);
+  }
+
+  [[nodiscard]] std::size_t Read(const std::size_t id) const {
+    std::shared_lock lock(mutex);
+    return graph.OutEdges(id).size() + (graph.GetNode(id) != nullptr);
+  }
+
+private:
+  mutable std::shared_mutex mutex;
+  xgraph::DiGraph<> graph;
+};
+
+/*!
+ * @brief `ConcurrentDiGraph` with the same interface
+ */
+class ShardedDiGraph {
+public:
+  void AddNode(const std::size_t id) { graph.AddNode(id); }
+
+  void AddEdge(const std::size_t s, const std::size_t t) {
+    graph.AddEdge(s, t);
+  }
+
+  [[nodiscard]] std::size_t Read(const std::size_t id) const {
+    return graph.OutEdges(id).size() + (graph.GetNode(id) != nullptr);
+  }
+
+private:
+  xgraph::ConcurrentDiGraph<> graph;
+};
+
+template <typename G>
+double ReadThroughput(const std::size_t reader_num,
+                      const std::size_t writer_num) {
+  G graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> reads{0};
+  std::vector<std::jthread> threads;
+
+  for (std::size_t w = 0; w < writer_num; ++w) {
+    threads.emplace_back([&graph, &stop, w] {
+      std::mt19937_64 rng(w);
+      while (!stop.load(std::memory_order_relaxed)) {
+        graph.AddEdge(rng() % NODE_NUM, rng() % NODE_NUM);
+      }
+    });
+  }
+
+  for (std::size_t r = 0; r < reader_num; ++r) {
+    threads.emplace_back([&graph, &stop, &reads, r] {
+      std::mt19937_64 rng(r + 1000);
+      std::size_t local{0};
+      std::size_t sink{0};
+      while (!stop.load(std::memory_order_relaxed)) {
+        sink += graph.Read(rng() % NODE_NUM);
+        ++local;
+      }
+      reads += local;
+      checksum += sink;
+    });
+  }
+
+  std::this_thread::sleep_for(DURATION);
+  stop = true;
+  threads.clear();
+
+  return static_cast<double>(reads.load()) /
+         std::chrono::duration<double>(DURATION).count();
+}
+
+int main() {
+  const auto max_readers =
+      std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+  std::printf("%-8s %-8s %18s %18s\n", "readers", "writers", "locked (op/s)",
+              "sharded (op/s)");
+  for (std::size_t readers = 1; readers <= max_readers; readers *= 2) {
+    for (const auto writers : {std::size_t{0}, WRITER_NUM}) {
+      const auto locked = ReadThroughput<LockedDiGraph>(readers, writers);
+      const auto sharded = ReadThroughput<ShardedDiGraph>(readers, writers);
+      std::printf("%-8zu %-8zu %18.0f %18.0f\n", readers, writers, locked,
+                  sharded);
+    }
+  }
+
+  return 0;
+}
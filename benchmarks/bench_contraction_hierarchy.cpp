@@ -0,0 +1,82 @@
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "algorithm/contraction_hierarchy.hpp"
+#include "bench_util.hpp"
+
+/*
+ * Preprocessing and queries of a contraction hierarchy on a road-like grid,
+ * against a single threaded `AStarPaths` batch and a reload of the
+ * serialized hierarchy.
+ */
+
+static constexpr std::size_t SIDE = 96;
+static constexpr std::size_t QUERY_NUM = 1024;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node, xgraph::EmptyObject, double>;
+using Hierarchy = xgraph::algorithm::ContractionHierarchy<Node, Edge>;
+
+int main() {
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < SIDE * SIDE; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> weight(1.0, 2.0);
+  for (std::size_t r = 0; r < SIDE; ++r) {
+    for (std::size_t c = 0; c < SIDE; ++c) {
+      const auto i = r * SIDE + c;
+      if (c + 1 < SIDE) {
+        graph.AddEdge(i, i + 1, weight(rng));
+        graph.AddEdge(i + 1, i, weight(rng));
+      }
+      if (r + 1 < SIDE) {
+        graph.AddEdge(i, i + SIDE, weight(rng));
+        graph.AddEdge(i + SIDE, i, weight(rng));
+      }
+    }
+  }
+
+  std::vector<xgraph::PathQuery_t<Node>> queries;
+  for (std::size_t q = 0; q < QUERY_NUM; ++q) {
+    queries.emplace_back(graph.GetNode(rng() % (SIDE * SIDE)),
+                         graph.GetNode(rng() % (SIDE * SIDE)));
+  }
+
+  std::printf("%-16s %12s %16s\n", "mode", "time (ms)", "path nodes");
+
+  const xgraph::CSRGraph<Node, Edge> csr(graph);
+  Hierarchy ch;
+  const auto build_ms = Millis([&] { ch = Hierarchy(csr); });
+  std::printf("%-16s %12.2f %16s\n", "CH preprocess", build_ms, "-");
+  std::printf("%-16s %12zu\n", "CH shortcuts", ch.ShortcutSize());
+
+  std::stringstream buffer;
+  const auto save_ms = Millis([&] { ch.Save(buffer); });
+  std::printf("%-16s %12.2f %16s\n", "CH save", save_ms, "-");
+  const auto load_ms =
+      Millis([&] { ch = Hierarchy::Load(buffer, graph); });
+  std::printf("%-16s %12.2f %16s\n", "CH load", load_ms, "-");
+
+  std::size_t nodes{0};
+  const auto astar_ms = Millis([&] {
+    for (const auto& res :
+         xgraph::algorithm::AStarPaths(csr, queries, {}, 1)) {
+      nodes += res.path.size();
+    }
+  });
+  std::printf("%-16s %12.2f %16zu\n", "AStarPaths x1", astar_ms, nodes);
+
+  nodes = 0;
+  const auto query_ms = Millis([&] {
+    for (const auto& [s, t] : queries) {
+      nodes += ch.Query(s, t).path.size();
+    }
+  });
+  std::printf("%-16s %12.2f %16zu\n", "CH queries", query_ms, nodes);
+
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#include "algorithm/cores.hpp"
+#include "bench_util.hpp"
+
+/*
+ * Core decomposition of a random skewed undirected graph: bucket peeling
+ * against level-synchronous peeling on 1 and all hardware threads, then
+ * extraction of the densest core.
+ */
+
+static constexpr std::size_t NODE_NUM = 100000;
+static constexpr std::size_t EDGE_NUM = 800000;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node>;
+
+int main() {
+  xgraph::Graph<Node, Edge> graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  const auto pick = [&] {
+    const auto x = unit(rng);
+    return static_cast<std::size_t>(x * x * NODE_NUM);
+  };
+  for (std::size_t k = 0; k < EDGE_NUM; ++k) {
+    const auto s = pick();
+    const auto t = pick();
+    if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+      graph.AddEdge(s, t);
+    }
+  }
+  const xgraph::CSRGraph csr(graph);
+
+  std::printf("%-16s %12s %16s\n", "mode", "time (ms)", "max core");
+
+  std::vector<std::size_t> cores;
+  const auto bucket_ms =
+      Millis([&] { cores = xgraph::algorithm::CoreNumbers(csr); });
+  std::printf("%-16s %12.2f %16zu\n", "bucket", bucket_ms,
+              std::ranges::max(cores));
+
+  const auto threads = xgraph::utils::WorkerCount(0);
+  for (const auto t : {std::size_t{1}, threads}) {
+    const auto ms = Millis([&] {
+      cores = xgraph::algorithm::ParallelCoreNumbers(
+          csr, xgraph::algorithm::CoreDegree::Total, t);
+    });
+    std::printf("parallel x%-6zu %12.2f %16zu\n", t, ms,
+                std::ranges::max(cores));
+  }
+
+  xgraph::CSRGraph<Node, Edge> core;
+  const auto extract_ms = Millis([&] {
+    core = xgraph::algorithm::ExtractCore(csr, cores, std::ranges::max(cores));
+  });
+  std::printf("%-16s %12.2f %16zu nodes\n", "extract", extract_ms,
+              core.NodeSize());
+
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "algorithm/multi_source_bfs.hpp"
+#include "bench_util.hpp"
+
+/*
+ * Distances from many sources: one breadth first search per source against
+ * batched multi-source BFS of different widths.
+ */
+
+static constexpr std::size_t NODE_NUM = 1 << 16;
+static constexpr std::size_t EDGE_NUM = 1 << 19;
+static constexpr std::size_t SOURCE_NUM = 512;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node, xgraph::EmptyObject, void>;
+using CSR = xgraph::CSRGraph<Node, Edge>;
+
+template <std::size_t Width>
+static void Report(const CSR& csr, const std::vector<std::size_t>& sources) {
+  std::size_t sum{0};
+  const auto ms = Millis([&] {
+    xgraph::algorithm::MultiSourceBFS<Width>(
+        csr, sources,
+        [&sum](const std::size_t, const std::size_t, const std::size_t d) {
+          sum += d;
+        });
+  });
+  std::printf("ms-bfs %-5zu %12.2f %16zu\n", Width, ms, sum);
+}
+
+int main() {
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937_64 rng(42);
+  for (std::size_t i = 0; i < EDGE_NUM; ++i) {
+    graph.AddEdge(rng() % NODE_NUM, rng() % NODE_NUM);
+  }
+  const CSR csr(graph);
+
+  std::vector<std::size_t> sources;
+  for (std::size_t i = 0; i < SOURCE_NUM; ++i) {
+    sources.push_back(rng() % NODE_NUM);
+  }
+
+  std::printf("%-12s %12s %16s\n", "mode", "time (ms)", "sum of depths");
+
+  std::size_t sum{0};
+  const auto single_ms = Millis([&] {
+    std::vector<std::size_t> dist(csr.NodeSize());
+    std::vector<std::size_t> queue;
+    for (const auto s : sources) {
+      std::ranges::fill(dist, CSR::npos);
+      queue.assign(1, s);
+      dist[s] = 0;
+      for (std::size_t head = 0; head < queue.size(); ++head) {
+        const auto v = queue[head];
+        sum += dist[v];
+        for (const auto w : csr.OutNeighbors(v)) {
+          if (dist[w] == CSR::npos) {
+            dist[w] = dist[v] + 1;
+            queue.push_back(w);
+          }
+        }
+      }
+    }
+  });
+  std::printf("%-12s %12.2f %16zu\n", "single", single_ms, sum);
+
+  Report<64>(csr, sources);
+  Report<128>(csr, sources);
+  Report<256>(csr, sources);
+  Report<512>(csr, sources);
+
+  return 0;
+}
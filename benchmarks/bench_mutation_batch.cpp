@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench_util.hpp"
+#include "structure/graph.hpp"
+
+/*
+ * Time of applying a stream of edge additions and removals through single
+ * `AddEdge` / `RemoveEdge` calls against one `MutationBatch`.
+ */
+
+static constexpr std::size_t NODE_NUM = 1 << 12;
+static constexpr std::size_t MUTATION_NUM = 1 << 18;
+
+struct Update {
+  bool add;
+  std::size_t source;
+  std::size_t target;
+};
+
+static std::vector<Update> MakeUpdates() {
+  std::mt19937_64 rng(42);
+  std::vector<Update> res;
+  res.reserve(MUTATION_NUM);
+  for (std::size_t i = 0; i < MUTATION_NUM; ++i) {
+    // One removal for three additions, partly cancelling each other
+    res.push_back({rng() % 4 != 0, rng() % NODE_NUM, rng() % NODE_NUM});
+  }
+  return res;
+}
+
+static xgraph::DiGraph<> MakeGraph() {
+  xgraph::DiGraph<> graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+  return graph;
+}
+
+int main() {
+  const auto updates = MakeUpdates();
+
+  auto single = MakeGraph();
+  const auto single_ms = Millis([&] {
+    for (const auto& [add, s, t] : updates) {
+      if (add) {
+        single.AddEdge(s, t);
+      } else {
+        single.RemoveEdge(s, t);
+      }
+    }
+  });
+
+  auto batched = MakeGraph();
+  const auto batched_ms = Millis([&] {
+    xgraph::MutationBatch<> batch;
+    for (const auto& [add, s, t] : updates) {
+      if (add) {
+        batch.AddEdge(s, t);
+      } else {
+        batch.RemoveEdge(s, t);
+      }
+    }
+    batched.Apply(batch);
+  });
+
+  std::printf("%-10s %12s %12s\n", "mode", "time (ms)", "edges");
+  std::printf("%-10s %12.1f %12zu\n", "single", single_ms,
+              single.Edges().size());
+  std::printf("%-10s %12.1f %12zu\n", "batched", batched_ms,
+              batched.Edges().size());
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "algorithm/landmarks.hpp"
+#include "algorithm/shortest_path.hpp"
+#include "bench_util.hpp"
+
+/*
+ * A batch of shortest path queries on a read-only grid: one `AStarPath` call
+ * per query against `AStarPaths` on 1 and all hardware threads, then
+ * single threaded batches without heuristic and with ALT landmarks.
+ */
+
+static constexpr std::size_t SIDE = 128;
+static constexpr std::size_t QUERY_NUM = 256;
+static constexpr std::size_t LANDMARK_NUM = 16;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node, xgraph::EmptyObject, double>;
+
+int main() {
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < SIDE * SIDE; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> weight(1.0, 2.0);
+  for (std::size_t r = 0; r < SIDE; ++r) {
+    for (std::size_t c = 0; c < SIDE; ++c) {
+      const auto i = r * SIDE + c;
+      if (c + 1 < SIDE) {
+        graph.AddEdge(i, i + 1, weight(rng));
+        graph.AddEdge(i + 1, i, weight(rng));
+      }
+      if (r + 1 < SIDE) {
+        graph.AddEdge(i, i + SIDE, weight(rng));
+        graph.AddEdge(i + SIDE, i, weight(rng));
+      }
+    }
+  }
+
+  std::vector<xgraph::PathQuery_t<Node>> queries;
+  for (std::size_t q = 0; q < QUERY_NUM; ++q) {
+    queries.emplace_back(graph.GetNode(rng() % (SIDE * SIDE)),
+                         graph.GetNode(rng() % (SIDE * SIDE)));
+  }
+
+  // Manhattan distance with the minimal weight
+  const std::optional<xgraph::Heuristic_t<Node>> heuristic =
+      [](const std::shared_ptr<Node>& n, const std::shared_ptr<Node>& t) {
+        const auto d = [](const std::size_t a, const std::size_t b) {
+          return a > b ? a - b : b - a;
+        };
+        return static_cast<double>(d(n->Id() / SIDE, t->Id() / SIDE) +
+                                   d(n->Id() % SIDE, t->Id() % SIDE));
+      };
+
+  std::printf("%-16s %12s %16s\n", "mode", "time (ms)", "path nodes");
+
+  std::size_t nodes{0};
+  const auto serial_ms = Millis([&] {
+    for (const auto& [s, t] : queries) {
+      nodes += xgraph::algorithm::AStarPath(graph, s, t, heuristic).size();
+    }
+  });
+  std::printf("%-16s %12.2f %16zu\n", "AStarPath loop", serial_ms, nodes);
+
+  const xgraph::CSRGraph csr(graph);
+  const auto threads = xgraph::utils::WorkerCount(0);
+  for (const auto t : {std::size_t{1}, threads}) {
+    nodes = 0;
+    const auto batch_ms = Millis([&] {
+      for (const auto& res :
+           xgraph::algorithm::AStarPaths(csr, queries, heuristic, t)) {
+        nodes += res.path.size();
+      }
+    });
+    std::printf("AStarPaths x%-4zu %12.2f %16zu\n", t, batch_ms, nodes);
+  }
+
+  nodes = 0;
+  const auto dijkstra_ms = Millis([&] {
+    for (const auto& res :
+         xgraph::algorithm::AStarPaths(csr, queries, {}, 1)) {
+      nodes += res.path.size();
+    }
+  });
+  std::printf("%-16s %12.2f %16zu\n", "no heuristic", dijkstra_ms, nodes);
+
+  using xgraph::algorithm::LandmarkSelection;
+  for (const auto selection :
+       {LandmarkSelection::Farthest, LandmarkSelection::Avoid}) {
+    const auto* name = selection == LandmarkSelection::Farthest
+                           ? "ALT farthest"
+                           : "ALT avoid";
+    std::optional<xgraph::algorithm::Landmarks<Node, Edge>> landmarks;
+    const auto build_ms =
+        Millis([&] { landmarks.emplace(csr, LANDMARK_NUM, selection); });
+    nodes = 0;
+    const auto alt_ms = Millis([&] {
+      for (const auto& res :
+           xgraph::algorithm::AStarPaths(csr, queries, *landmarks, 1)) {
+        nodes += res.path.size();
+      }
+    });
+    std::printf("%-16s %12.2f %16zu (build %.2f ms)\n", name, alt_ms, nodes,
+                build_ms);
+  }
+
+  return 0;
+}
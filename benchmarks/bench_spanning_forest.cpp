@@ -0,0 +1,56 @@
+#include <cstdio>
+#include <random>
+
+#include "algorithm/spanning_forest.hpp"
+#include "bench_util.hpp"
+
+/*
+ * Minimum spanning forest of a random weighted undirected graph at two
+ * densities: filter-Kruskal against parallel Boruvka on 1 and all hardware
+ * threads.
+ */
+
+static constexpr std::size_t NODE_NUM = 50000;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node, xgraph::EmptyObject, double>;
+
+int main() {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> weight(0.0, 1.0);
+  const auto threads = xgraph::utils::WorkerCount(0);
+
+  std::printf("%-8s %-16s %12s %16s\n", "degree", "mode", "time (ms)",
+              "weight");
+  for (const auto degree : {std::size_t{2}, std::size_t{16}}) {
+    xgraph::Graph<Node, Edge> graph;
+    for (std::size_t i = 0; i < NODE_NUM; ++i) {
+      graph.AddNode(i);
+    }
+    for (std::size_t k = 0; k < degree * NODE_NUM / 2; ++k) {
+      const auto s = rng() % NODE_NUM;
+      const auto t = rng() % NODE_NUM;
+      if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+        graph.AddEdge(s, t, weight(rng));
+      }
+    }
+    const xgraph::CSRGraph csr(graph);
+
+    double total{0.0};
+    const auto kruskal_ms = Millis([&] {
+      total = xgraph::algorithm::FilterKruskalForest(csr).weight;
+    });
+    std::printf("%-8zu %-16s %12.2f %16.4f\n", degree, "filter-Kruskal",
+                kruskal_ms, total);
+
+    for (const auto t : {std::size_t{1}, threads}) {
+      const auto ms = Millis([&] {
+        total = xgraph::algorithm::MinimumSpanningForest(csr, t).weight;
+      });
+      std::printf("%-8zu Boruvka x%-7zu %12.2f %16.4f\n", degree, t, ms,
+                  total);
+    }
+  }
+
+  return 0;
+}
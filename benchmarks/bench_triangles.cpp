@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <random>
+
+#include "algorithm/triangles.hpp"
+#include "bench_util.hpp"
+
+/*
+ * Triangle counting on a random undirected graph: hash set intersections of
+ * `Neighbors()` for every edge against the degree-oriented sorted
+ * intersections on 1 and all hardware threads, then per-node counts.
+ */
+
+static constexpr std::size_t NODE_NUM = 5000;
+static constexpr std::size_t EDGE_NUM = 50000;
+
+using Node = xgraph::XNode<>;
+using Edge = xgraph::XEdge<Node>;
+
+int main() {
+  xgraph::Graph<Node, Edge> graph;
+  for (std::size_t i = 0; i < NODE_NUM; ++i) {
+    graph.AddNode(i);
+  }
+  // Skewed endpoints, so that some nodes have large degrees
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  const auto pick = [&] {
+    const auto x = unit(rng);
+    return static_cast<std::size_t>(x * x * NODE_NUM);
+  };
+  for (std::size_t k = 0; k < EDGE_NUM; ++k) {
+    const auto s = pick();
+    const auto t = pick();
+    if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+      graph.AddEdge(s, t);
+    }
+  }
+
+  std::printf("%-16s %12s %16s\n", "mode", "time (ms)", "triangles");
+
+  std::size_t count{0};
+  const auto hash_ms = Millis([&] {
+    for (std::size_t u = 0; u < NODE_NUM; ++u) {
+      const auto nu = graph.Neighbors(u);
+      for (const auto& v : nu) {
+        if (v->Id() <= u) {
+          continue;
+        }
+        for (const auto& w : graph.Neighbors(v->Id())) {
+          if (w->Id() > v->Id() && nu.contains(w)) {
+            ++count;
+          }
+        }
+      }
+    }
+  });
+  std::printf("%-16s %12.2f %16zu\n", "Neighbors()", hash_ms, count);
+
+  const xgraph::CSRGraph csr(graph);
+  const auto threads = xgraph::utils::WorkerCount(0);
+  for (const auto t : {std::size_t{1}, threads}) {
+    const auto ms = Millis(
+        [&] { count = xgraph::algorithm::CountTriangles(csr, t); });
+    std::printf("count x%-9zu %12.2f %16zu\n", t, ms, count);
+  }
+
+  const auto node_ms = Millis([&] {
+    const auto counts = xgraph::algorithm::NodeTriangles(csr, threads);
+    count = 0;
+    for (const auto c : counts) {
+      count += c;
+    }
+  });
+  std::printf("%-16s %12.2f %16zu\n", "per node / 3", node_ms, count / 3);
+
+  return 0;
+}
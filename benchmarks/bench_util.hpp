@@ -0,0 +1,16 @@
+#pragma once
+
+#include <chrono>
+
+/*!
+ * @brief Wall time of a call
+ * @param func Callable
+ * @return Elapsed milliseconds
+ */
+template <typename Func> double Millis(Func&& func) {
+  const auto start = std::chrono::steady_clock::now();
+  func();
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
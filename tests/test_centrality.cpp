@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+static bool close(const std::vector<double>& lhs,
+                  const std::vector<double>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    if (std::abs(lhs[i] - rhs[i]) > 1e-9) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST_CASE("Betweenness Centrality", "DiGraph") {
+  using Node = XNode<>;
+
+  SECTION("Unweighted") {
+    using Edge = XEdge<Node, xgraph::EmptyObject, void>;
+
+    // Path 0 - 1 - 2 - 3 - 4
+    xgraph::Graph<Node, Edge> path;
+    for (std::size_t i = 0; i < 5; ++i) {
+      path.AddNode(i);
+    }
+    for (std::size_t i = 0; i + 1 < 5; ++i) {
+      path.AddEdge(i, i + 1);
+    }
+    REQUIRE(close(xgraph::algorithm::Betweenness(path),
+                  {0.0, 3.0, 4.0, 3.0, 0.0}));
+
+    // Directed diamond 0 -> {1, 2} -> 3 -> 4, two shortest paths from 0
+    xgraph::DiGraph<Node, Edge> diamond;
+    for (std::size_t i = 0; i < 5; ++i) {
+      diamond.AddNode(i);
+    }
+    diamond.AddEdge(0, 1);
+    diamond.AddEdge(0, 2);
+    diamond.AddEdge(1, 3);
+    diamond.AddEdge(2, 3);
+    diamond.AddEdge(3, 4);
+    REQUIRE(close(xgraph::algorithm::Betweenness(diamond),
+                  {0.0, 1.0, 1.0, 3.0, 0.0}));
+  }
+
+  SECTION("Weighted") {
+    using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+
+    // The heavy edge 0 - 1 is bypassed through 2
+    xgraph::Graph<Node, Edge> triangle;
+    for (std::size_t i = 0; i < 3; ++i) {
+      triangle.AddNode(i);
+    }
+    triangle.AddEdge(0, 1, 5.0);
+    triangle.AddEdge(0, 2, 1.0);
+    triangle.AddEdge(2, 1, 1.0);
+    REQUIRE(close(xgraph::algorithm::Betweenness(triangle), {0.0, 0.0, 1.0}));
+
+    triangle.AddNode(3);
+    triangle.AddEdge(3, 0, 0.0);
+    REQUIRE_THROWS_AS(xgraph::algorithm::Betweenness(triangle),
+                      std::invalid_argument);
+  }
+
+  SECTION("Parallel and sampled") {
+    using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+    constexpr std::size_t size = 120;
+
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < size; ++i) {
+      graph.AddNode(i);
+    }
+    std::mt19937 rng(3);
+    for (std::size_t i = 0; i < 4 * size; ++i) {
+      const auto s = rng() % size;
+      const auto t = rng() % size;
+      if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+        graph.AddEdge(s, t, static_cast<double>(1 + rng() % 3));
+      }
+    }
+    const xgraph::CSRGraph<Node, Edge> csr(graph);
+
+    const auto exact = xgraph::algorithm::Betweenness(csr, 0, 1);
+    REQUIRE(close(xgraph::algorithm::Betweenness(csr, 0, 4), exact));
+    REQUIRE(close(xgraph::algorithm::Betweenness(csr, size, 4), exact));
+
+    const auto sampled = xgraph::algorithm::Betweenness(csr, 30, 4, 11);
+    REQUIRE(close(xgraph::algorithm::Betweenness(csr, 30, 1, 11), sampled));
+    double exact_sum{0.0};
+    double sampled_sum{0.0};
+    for (std::size_t v = 0; v < size; ++v) {
+      REQUIRE(sampled[v] >= 0.0);
+      exact_sum += exact[v];
+      sampled_sum += sampled[v];
+    }
+    // The estimate of the total stays in the right range
+    REQUIRE(sampled_sum > exact_sum / 2);
+    REQUIRE(sampled_sum < exact_sum * 2);
+  }
+}
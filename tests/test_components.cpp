@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+// Whether two labelings induce the same partition
+static bool SamePartition(const std::vector<std::size_t>& lhs,
+                          const std::vector<std::size_t>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  std::map<std::size_t, std::size_t> forward;
+  std::map<std::size_t, std::size_t> backward;
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    if (forward.try_emplace(lhs[i], rhs[i]).first->second != rhs[i] ||
+        backward.try_emplace(rhs[i], lhs[i]).first->second != lhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST_CASE("Strongly Connected Components", "CSRGraph") {
+  using Node = XNode<>;
+  using Edge = XEdge<Node>;
+
+  SECTION("Small graph") {
+    // {0 1 2} -> {3 4} -> 5, 6 alone with a self loop
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < 7; ++i) {
+      graph.AddNode(i);
+    }
+    graph.AddEdge(0, 1);
+    graph.AddEdge(1, 2);
+    graph.AddEdge(2, 0);
+    graph.AddEdge(2, 3);
+    graph.AddEdge(3, 4);
+    graph.AddEdge(4, 3);
+    graph.AddEdge(4, 5);
+    graph.AddEdge(6, 6);
+
+    const auto component =
+        xgraph::algorithm::StronglyConnectedComponents(graph);
+    REQUIRE(component[0] == component[1]);
+    REQUIRE(component[1] == component[2]);
+    REQUIRE(component[3] == component[4]);
+    // Sinks first
+    REQUIRE(component[5] < component[3]);
+    REQUIRE(component[3] < component[0]);
+    REQUIRE(SamePartition(component, {0, 0, 0, 1, 1, 2, 3}));
+    REQUIRE(SamePartition(
+        xgraph::algorithm::ParallelStronglyConnectedComponents(graph, 4),
+        component));
+
+    const xgraph::CSRGraph<Node, Edge> csr(graph);
+    const auto dag = xgraph::algorithm::Condensation(csr, component);
+    REQUIRE(dag.NodeSize() == 4);
+    REQUIRE(dag.EdgeSize() == 2);
+    REQUIRE(dag.GetEdge(component[0], component[3], std::nullopt));
+    REQUIRE(dag.GetEdge(component[3], component[5], std::nullopt));
+
+    // The condensation is acyclic while the graph is not
+    std::vector<std::size_t> order;
+    const std::optional<xgraph::NodePtrVisitor_t<XNode<>>> record =
+        [&order](const std::shared_ptr<XNode<>>& n) {
+          order.push_back(n->Id());
+        };
+    xgraph::algorithm::TopologicalSort(dag, record);
+    REQUIRE(order.size() == 4);
+    REQUIRE_THROWS_AS(xgraph::algorithm::TopologicalSort(graph),
+                      std::runtime_error);
+  }
+
+  SECTION("Deep chain") {
+    // One cycle through 200000 nodes, deeper than any recursive search
+    constexpr std::size_t size = 200000;
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < size; ++i) {
+      graph.AddNode(i);
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      graph.AddEdge(i, (i + 1) % size);
+    }
+    const xgraph::CSRGraph<Node, Edge> csr(graph);
+    REQUIRE(xgraph::algorithm::StronglyConnectedComponents(csr) ==
+            std::vector<std::size_t>(size, 0));
+    REQUIRE(xgraph::algorithm::ParallelStronglyConnectedComponents(csr, 4) ==
+            std::vector<std::size_t>(size, 0));
+  }
+
+  SECTION("Rounds large enough for the worker pool") {
+    // 2000 sources trimmed in one round, then 8 cycles of 300 nodes chained
+    // as 4 5 6 7 0 1 2 3, so the first pivot splits them in two
+    constexpr std::size_t sources = 2000;
+    constexpr std::size_t cycles = 8;
+    constexpr std::size_t length = 300;
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < sources + cycles * length; ++i) {
+      graph.AddNode(i);
+    }
+    for (std::size_t c = 0; c < cycles; ++c) {
+      const auto first = sources + c * length;
+      for (std::size_t i = 0; i < length; ++i) {
+        graph.AddEdge(first + i, first + (i + 1) % length);
+      }
+      if (c + 1 != cycles / 2) {
+        const auto next = sources + (c + 1) % cycles * length;
+        graph.AddEdge(first, next);
+      }
+    }
+    for (std::size_t i = 0; i < sources; ++i) {
+      graph.AddEdge(i, sources + i % (cycles * length));
+    }
+    const xgraph::CSRGraph<Node, Edge> csr(graph);
+    const auto component = xgraph::algorithm::StronglyConnectedComponents(csr);
+    REQUIRE(*std::ranges::max_element(component) == sources + cycles - 1);
+    REQUIRE(SamePartition(
+        xgraph::algorithm::ParallelStronglyConnectedComponents(csr, 4),
+        component));
+  }
+
+  SECTION("Random graphs against reachability") {
+    constexpr std::size_t size = 120;
+    std::mt19937 rng(17);
+    for (const auto degree : {std::size_t{1}, std::size_t{2}}) {
+      xgraph::DiGraph<Node, Edge> graph;
+      for (std::size_t i = 0; i < size; ++i) {
+        graph.AddNode(i);
+      }
+      for (std::size_t k = 0; k < degree * size; ++k) {
+        const auto s = rng() % size;
+        const auto t = rng() % size;
+        if (!graph.GetEdge(s, t, std::nullopt)) {
+          graph.AddEdge(s, t);
+        }
+      }
+      const xgraph::CSRGraph<Node, Edge> csr(graph);
+
+      // Mutual reachability by transitive closure
+      std::vector<std::vector<bool>> reach(size, std::vector<bool>(size));
+      for (std::size_t v = 0; v < size; ++v) {
+        reach[v][v] = true;
+        for (const auto u : csr.OutNeighbors(v)) {
+          reach[v][u] = true;
+        }
+      }
+      for (std::size_t k = 0; k < size; ++k) {
+        for (std::size_t i = 0; i < size; ++i) {
+          for (std::size_t j = 0; reach[i][k] && j < size; ++j) {
+            if (reach[k][j]) {
+              reach[i][j] = true;
+            }
+          }
+        }
+      }
+
+      const auto component =
+          xgraph::algorithm::StronglyConnectedComponents(csr);
+      for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) {
+          REQUIRE((component[i] == component[j]) ==
+                  (reach[i][j] && reach[j][i]));
+          // Reverse topological numbering
+          if (reach[i][j] && component[i] != component[j]) {
+            REQUIRE(component[i] > component[j]);
+          }
+        }
+      }
+      for (const auto threads : {std::size_t{1}, std::size_t{4}}) {
+        const auto parallel =
+            xgraph::algorithm::ParallelStronglyConnectedComponents(csr,
+                                                                   threads);
+        REQUIRE(SamePartition(parallel, component));
+        REQUIRE(*std::ranges::max_element(parallel) ==
+                *std::ranges::max_element(component));
+      }
+    }
+  }
+}
@@ -0,0 +1,226 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+static constexpr std::size_t N = 64;
+static constexpr std::size_t WRITER_NUM = 4;
+static constexpr std::size_t READER_NUM = 4;
+
+TEST_CASE("ConcurrentDiGraph Structure", "ConcurrentDiGraph") {
+  xgraph::ConcurrentDiGraph<> graph(4);
+  REQUIRE(graph.IsDirected());
+
+  graph.AddNode(std::make_shared<XNode<>>("source"));
+  graph.AddNode("target");
+  graph.AddNode("target"); // no effect
+  REQUIRE(graph.NodeSize() == 2);
+  REQUIRE(graph.HasNode("source"));
+
+  graph.AddEdge("source", "target", 2);
+  graph.AddEdge("source", "missing"); // no effect
+  REQUIRE(graph.EdgeSize() == 1);
+
+  const auto s_id = graph.GetNode("source")->Id();
+  const auto t_id = graph.GetNode("target")->Id();
+  REQUIRE(graph.HasEdge(s_id, t_id));
+  REQUIRE_FALSE(graph.HasEdge(t_id, s_id));
+  REQUIRE(graph.GetEdge(s_id, t_id)->Weight() == 2);
+  REQUIRE(graph.OutEdges(s_id).size() == 1);
+  REQUIRE(graph.InEdges(t_id).size() == 1);
+  REQUIRE(graph.Children(s_id).front()->Name() == "target");
+  REQUIRE(graph.Parents(t_id).front()->Name() == "source");
+
+  graph.RemoveEdge(s_id, t_id);
+  REQUIRE(graph.EdgeSize() == 0);
+  REQUIRE(graph.InEdges(t_id).empty());
+
+  graph.AddEdge(s_id, t_id);
+  graph.AddEdge(t_id, t_id);
+  graph.RemoveNode("target");
+  REQUIRE_FALSE(graph.HasNode("target"));
+  REQUIRE(graph.NodeSize() == 1);
+  REQUIRE(graph.EdgeSize() == 0);
+  REQUIRE(graph.OutEdges(s_id).empty());
+}
+
+TEST_CASE("ConcurrentDiGraph Readers and Writers", "ConcurrentDiGraph") {
+  xgraph::ConcurrentDiGraph<> graph;
+  for (std::size_t i = 0; i < N; ++i) {
+    graph.AddNode(i);
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> inconsistent{0};
+  {
+    std::vector<std::jthread> readers;
+    for (std::size_t r = 0; r < READER_NUM; ++r) {
+      readers.emplace_back([&graph, &stop, &inconsistent] {
+        while (!stop) {
+          for (std::size_t i = 0; i < N; ++i) {
+            for (const auto& e : graph.OutEdges(i)) {
+              if (e->Source()->Id() != i || !graph.HasNode(e->Target()->Id())) {
+                ++inconsistent;
+              }
+            }
+            if (graph.GetNode(i) == nullptr) {
+              ++inconsistent;
+            }
+          }
+        }
+      });
+    }
+
+    // Every writer adds edges from its own residue class of sources
+    std::vector<std::jthread> writers;
+    for (std::size_t w = 0; w < WRITER_NUM; ++w) {
+      writers.emplace_back([&graph, w] {
+        for (std::size_t s = w; s < N; s += WRITER_NUM) {
+          for (std::size_t t = 0; t < N; ++t) {
+            graph.AddEdge(s, t);
+          }
+        }
+      });
+    }
+    writers.clear();
+    stop = true;
+  }
+
+  REQUIRE(inconsistent == 0);
+  REQUIRE(graph.EdgeSize() == N * N);
+  for (std::size_t i = 0; i < N; ++i) {
+    REQUIRE(graph.OutEdges(i).size() == N);
+    REQUIRE(graph.InEdges(i).size() == N);
+  }
+}
+
+TEST_CASE("ConcurrentDiGraph Snapshot", "ConcurrentDiGraph") {
+  xgraph::ConcurrentDiGraph<> graph(4);
+  for (std::size_t i = 0; i < N; ++i) {
+    graph.AddNode(i);
+  }
+  for (std::size_t i = 0; i + 1 < N; ++i) {
+    graph.AddEdge(i, i + 1);
+  }
+
+  {
+    const auto snapshot = graph.Snapshot();
+    REQUIRE(snapshot.Version() == graph.Version());
+
+    graph.RemoveEdge(0, 1);
+    graph.AddEdge(1, 0);
+    graph.RemoveNode(N - 1);
+    graph.AddNode(N);
+    REQUIRE_FALSE(graph.HasEdge(0, 1));
+    REQUIRE_FALSE(graph.HasNode(N - 1));
+
+    // The snapshot still observes the chain
+    REQUIRE(snapshot.HasEdge(0, 1));
+    REQUIRE_FALSE(snapshot.HasEdge(1, 0));
+    REQUIRE(snapshot.HasNode(N - 1));
+    REQUIRE_FALSE(snapshot.HasNode(N));
+    REQUIRE(snapshot.NodeSize() == N);
+    REQUIRE(snapshot.EdgeSize() == N - 1);
+    REQUIRE(snapshot.Children(N - 2).front()->Id() == N - 1);
+    REQUIRE(snapshot.Parents(1).front()->Id() == 0);
+
+    const auto latest = graph.Snapshot();
+    REQUIRE(latest.Version() > snapshot.Version());
+    REQUIRE(latest.HasEdge(1, 0));
+    REQUIRE_FALSE(latest.HasNode(N - 1));
+    REQUIRE(latest.NodeSize() == N);
+    REQUIRE(latest.EdgeSize() == N - 2);
+    REQUIRE(latest.OutEdges(N - 2).empty());
+    REQUIRE(graph.RetainedVersions() > N + 1);
+  }
+
+  // Released snapshots let old versions go
+  graph.Reclaim();
+  REQUIRE(graph.RetainedVersions() == graph.NodeSize());
+}
+
+TEST_CASE("ConcurrentDiGraph Snapshot Isolation", "ConcurrentDiGraph") {
+  xgraph::ConcurrentDiGraph<> graph;
+  for (std::size_t i = 0; i < N; ++i) {
+    graph.AddNode(i);
+  }
+
+  std::atomic<bool> stop{false};
+  std::atomic<std::size_t> inconsistent{0};
+  {
+    std::vector<std::jthread> readers;
+    for (std::size_t r = 0; r < READER_NUM; ++r) {
+      readers.emplace_back([&graph, &stop, &inconsistent] {
+        std::size_t last{0};
+        while (!stop) {
+          const auto snapshot = graph.Snapshot();
+          const auto edge_size = snapshot.EdgeSize();
+          std::size_t in_size{0};
+          for (std::size_t i = 0; i < N; ++i) {
+            in_size += snapshot.InEdges(i).size();
+          }
+          // Edges are only added, so every snapshot sees at least as many
+          if (edge_size != in_size || edge_size != snapshot.EdgeSize() ||
+              edge_size < last) {
+            ++inconsistent;
+          }
+          last = edge_size;
+        }
+      });
+    }
+
+    std::vector<std::jthread> writers;
+    for (std::size_t w = 0; w < WRITER_NUM; ++w) {
+      writers.emplace_back([&graph, w] {
+        for (std::size_t s = w; s < N; s += WRITER_NUM) {
+          for (std::size_t t = 0; t < N; ++t) {
+            graph.AddEdge(s, t);
+          }
+        }
+      });
+    }
+    writers.clear();
+    stop = true;
+  }
+
+  REQUIRE(inconsistent == 0);
+  REQUIRE(graph.Snapshot().EdgeSize() == N * N);
+  graph.Reclaim();
+  REQUIRE(graph.RetainedVersions() == N);
+}
+
+TEST_CASE("ConcurrentDiGraph Name Index", "ConcurrentDiGraph") {
+  xgraph::ConcurrentDiGraph<> graph;
+  std::vector<std::shared_ptr<XNode<>>> nodes;
+  for (std::size_t i = 0; i < N; ++i) {
+    nodes.push_back(std::make_shared<XNode<>>(i));
+  }
+
+  // Adding and removing the same nodes concurrently keeps names and ids in
+  // agreement
+  {
+    std::vector<std::jthread> writers;
+    for (std::size_t w = 0; w < WRITER_NUM; ++w) {
+      writers.emplace_back([&graph, &nodes, w] {
+        for (std::size_t round = 0; round < 50; ++round) {
+          for (std::size_t i = 0; i < N; ++i) {
+            if ((i + round + w) % 2 == 0) {
+              graph.AddNode(nodes[i]);
+            } else {
+              graph.RemoveNode(i);
+            }
+          }
+        }
+      });
+    }
+  }
+
+  for (std::size_t i = 0; i < N; ++i) {
+    REQUIRE(graph.GetNode(nodes[i]->Name()) == graph.GetNode(i));
+  }
+}
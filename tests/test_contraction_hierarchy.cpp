@@ -0,0 +1,216 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+using Node = XNode<>;
+using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+
+static xgraph::DiGraph<Node, Edge> random_graph(const std::size_t size) {
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < size; ++i) {
+    graph.AddNode(i);
+  }
+  // Integral weights keep sums exact
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<std::size_t> node(0, size - 1);
+  std::uniform_int_distribution<int> weight(1, 9);
+  for (std::size_t i = 0; i < size * 3; ++i) {
+    const auto s = node(gen);
+    const auto t = node(gen);
+    if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+      graph.AddEdge(s, t, static_cast<double>(weight(gen)));
+    }
+  }
+  graph.AddNode("isolated");
+  return graph;
+}
+
+TEST_CASE("Contraction Hierarchy Query", "DiGraph") {
+  constexpr std::size_t size = 80;
+  const auto graph = random_graph(size);
+  std::vector<xgraph::PathQuery_t<Node>> queries;
+  for (std::size_t s = 0; s < size; s += 3) {
+    for (std::size_t t = 0; t < size; ++t) {
+      queries.emplace_back(graph.GetNode(s), graph.GetNode(t));
+    }
+  }
+  const auto expected = xgraph::algorithm::AStarPaths(graph, queries);
+
+  // A tiny witness limit keeps more shortcuts but must stay exact
+  for (const auto limit : {std::size_t{1}, std::size_t{500}}) {
+    const xgraph::algorithm::ContractionHierarchy<Node, Edge> ch(graph, limit);
+    REQUIRE(ch.NodeSize() == graph.NodeSize());
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      const auto& [source, target] = queries[i];
+      const auto res = ch.Query(source, target);
+      REQUIRE(res.reachable == expected[i].reachable);
+      if (!res.reachable) {
+        REQUIRE(res.path.empty());
+        continue;
+      }
+      REQUIRE(res.cost == expected[i].cost);
+      REQUIRE(res.path.front() == source);
+      REQUIRE(res.path.back() == target);
+
+      // Unpacked paths only use original edges
+      double sum{0.0};
+      for (std::size_t k = 1; k < res.path.size(); ++k) {
+        const auto edge = graph.GetEdge(res.path[k - 1]->Id(),
+                                        res.path[k]->Id(), std::nullopt);
+        REQUIRE(edge);
+        sum += edge->Weight();
+      }
+      REQUIRE(sum == res.cost);
+    }
+  }
+
+  const xgraph::algorithm::ContractionHierarchy<Node, Edge> ch(graph);
+  const auto self = ch.Query(graph.GetNode(4), graph.GetNode(4));
+  REQUIRE(self.reachable);
+  REQUIRE(self.path.size() == 1);
+  REQUIRE(self.cost == 0.0);
+  REQUIRE_FALSE(
+      ch.Query(graph.GetNode(0), graph.GetNode("isolated")).reachable);
+  REQUIRE_FALSE(
+      ch.Query(graph.GetNode(0), std::make_shared<Node>("missing")).reachable);
+  REQUIRE(ch.Rank(std::make_shared<Node>("missing")) ==
+          xgraph::CSRGraph<Node, Edge>::npos);
+
+  xgraph::DiGraph<Node, Edge> negative;
+  negative.AddNode("a");
+  negative.AddNode("b");
+  negative.AddEdge("a", "b", -1.0);
+  REQUIRE_THROWS_AS(
+      (xgraph::algorithm::ContractionHierarchy<Node, Edge>(negative)),
+      std::invalid_argument);
+}
+
+TEST_CASE("Contraction Hierarchy Serialization", "DiGraph") {
+  constexpr std::size_t size = 50;
+  const auto graph = random_graph(size);
+  const xgraph::algorithm::ContractionHierarchy<Node, Edge> ch(graph);
+
+  std::stringstream buffer;
+  ch.Save(buffer);
+  const auto loaded =
+      xgraph::algorithm::ContractionHierarchy<Node, Edge>::Load(buffer, graph);
+  REQUIRE(loaded.NodeSize() == ch.NodeSize());
+  REQUIRE(loaded.ShortcutSize() == ch.ShortcutSize());
+
+  for (std::size_t s = 0; s < size; ++s) {
+    REQUIRE(loaded.Rank(graph.GetNode(s)) == ch.Rank(graph.GetNode(s)));
+    for (std::size_t t = 0; t < size; t += 7) {
+      const auto lhs = ch.Query(graph.GetNode(s), graph.GetNode(t));
+      const auto rhs = loaded.Query(graph.GetNode(s), graph.GetNode(t));
+      REQUIRE(lhs.reachable == rhs.reachable);
+      REQUIRE(lhs.cost == rhs.cost);
+      REQUIRE(lhs.path == rhs.path);
+    }
+  }
+
+  // Truncated data and graphs missing nodes are rejected
+  std::stringstream truncated(buffer.str().substr(0, 40));
+  REQUIRE_THROWS_AS(
+      (xgraph::algorithm::ContractionHierarchy<Node, Edge>::Load(truncated,
+                                                                 graph)),
+      std::runtime_error);
+  std::stringstream again(buffer.str());
+  REQUIRE_THROWS_AS(
+      (xgraph::algorithm::ContractionHierarchy<Node, Edge>::Load(
+          again, xgraph::DiGraph<Node, Edge>{})),
+      std::runtime_error);
+}
+
+TEST_CASE("Contraction Hierarchy Corrupt Data", "DiGraph") {
+  using Hierarchy = xgraph::algorithm::ContractionHierarchy<Node, Edge>;
+  constexpr std::size_t size = 50;
+  const auto graph = random_graph(size);
+  std::stringstream buffer;
+  Hierarchy(graph).Save(buffer);
+  const auto data = buffer.str();
+
+  // Layout: magic, format, node size, shortcut size, then node ids, ranks,
+  // up offsets, up arcs, down offsets and down arcs
+  constexpr std::size_t n = size + 1;
+  constexpr std::size_t ranks = 24 + 8 * n;
+  constexpr std::size_t up_offsets = ranks + 8 * n;
+  constexpr std::size_t up_arcs = up_offsets + 8 * (n + 1);
+  const auto patch = [&data](const std::size_t pos,
+                             const std::uint64_t value) {
+    auto res = data;
+    std::memcpy(res.data() + pos, &value, sizeof(value));
+    return res;
+  };
+  const auto load = [&graph](const std::string& bytes) {
+    std::stringstream in(bytes);
+    return Hierarchy::Load(in, graph);
+  };
+  const auto read = [&data](const std::size_t pos) {
+    std::uint64_t value{0};
+    std::memcpy(&value, data.data() + pos, sizeof(value));
+    return value;
+  };
+  // First node with upward arcs
+  std::size_t first_up{0};
+  while (read(up_offsets + 8 * first_up) ==
+         read(up_offsets + 8 * (first_up + 1))) {
+    ++first_up;
+  }
+  REQUIRE(first_up < n);
+
+  SECTION("Truncated anywhere") {
+    for (std::size_t length = 0; length < data.size(); length += 13) {
+      REQUIRE_THROWS_AS(load(data.substr(0, length)), std::runtime_error);
+    }
+  }
+
+  SECTION("Sizes larger than the data") {
+    REQUIRE_THROWS_AS(load(patch(8, std::uint64_t{1} << 60)),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(load(patch(up_arcs - 8, std::uint64_t{1} << 60)),
+                      std::runtime_error);
+  }
+
+  SECTION("Offsets, ranks and arcs out of range") {
+    // Offsets not starting at 0 or decreasing
+    REQUIRE_THROWS_AS(load(patch(up_offsets, 1)), std::runtime_error);
+    REQUIRE_THROWS_AS(
+        load(patch(up_offsets + 8 * first_up,
+                   read(up_offsets + 8 * (first_up + 1)) + 1)),
+        std::runtime_error);
+    // Ranks not a permutation
+    REQUIRE_THROWS_AS(load(patch(ranks + 8, read(ranks))),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(load(patch(ranks, n)), std::runtime_error);
+    // Arc to a missing node, then to a node of lower rank
+    const auto arc = up_arcs + 24 * read(up_offsets + 8 * first_up);
+    REQUIRE_THROWS_AS(load(patch(arc, n)), std::runtime_error);
+    REQUIRE_THROWS_AS(load(patch(arc, first_up)), std::runtime_error);
+    // Skipped node missing
+    REQUIRE_THROWS_AS(load(patch(arc + 16, n)), std::runtime_error);
+  }
+
+  SECTION("Random corruption never reads out of bounds") {
+    std::mt19937 gen(11);
+    for (std::size_t round = 0; round < 200; ++round) {
+      auto bytes = data;
+      bytes[gen() % bytes.size()] = static_cast<char>(gen());
+      try {
+        const auto loaded = load(bytes);
+        for (std::size_t t = 0; t < size; t += 5) {
+          (void)loaded.Query(graph.GetNode(0), graph.GetNode(t));
+        }
+      } catch (const std::runtime_error&) {
+      }
+    }
+  }
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+using xgraph::algorithm::CoreDegree;
+
+// Core numbers by definition: the k-core is what is left after repeatedly
+// removing nodes of degree less than k
+template <typename Node, typename Edge>
+static std::vector<std::size_t>
+NaiveCores(const xgraph::CSRGraph<Node, Edge>& csr, const CoreDegree mode) {
+  const auto n = csr.NodeSize();
+  std::vector<std::size_t> res(n, 0);
+  for (std::size_t k = 1;; ++k) {
+    std::vector<bool> alive(n, true);
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (std::size_t v = 0; v < n; ++v) {
+        if (!alive[v]) {
+          continue;
+        }
+        std::size_t degree{0};
+        if (!csr.IsDirected() || mode != CoreDegree::In) {
+          for (const auto u : csr.OutNeighbors(v)) {
+            degree += alive[u] ? 1 : 0;
+          }
+        }
+        if (csr.IsDirected() && mode != CoreDegree::Out) {
+          for (const auto u : csr.InNeighbors(v)) {
+            degree += alive[u] ? 1 : 0;
+          }
+        }
+        if (degree < k) {
+          alive[v] = false;
+          changed = true;
+        }
+      }
+    }
+    bool any{false};
+    for (std::size_t v = 0; v < n; ++v) {
+      if (alive[v]) {
+        res[v] = k;
+        any = true;
+      }
+    }
+    if (!any) {
+      return res;
+    }
+  }
+}
+
+TEST_CASE("Core Decomposition", "CSRGraph") {
+  using Node = XNode<>;
+  using Edge = XEdge<Node>;
+
+  SECTION("Undirected") {
+    // Triangle 0 1 2 with a 4-clique 3 4 5 6 attached to 2, and leaf 7
+    xgraph::Graph<Node, Edge> graph;
+    for (std::size_t i = 0; i < 8; ++i) {
+      graph.AddNode(i);
+    }
+    graph.AddEdge(0, 1);
+    graph.AddEdge(1, 2);
+    graph.AddEdge(2, 0);
+    graph.AddEdge(2, 3);
+    for (std::size_t i = 3; i < 7; ++i) {
+      for (std::size_t j = i + 1; j < 7; ++j) {
+        graph.AddEdge(i, j);
+      }
+    }
+    graph.AddEdge(6, 7);
+
+    const std::vector<std::size_t> expected{2, 2, 2, 3, 3, 3, 3, 1};
+    REQUIRE(xgraph::algorithm::CoreNumbers(graph) == expected);
+    REQUIRE(xgraph::algorithm::ParallelCoreNumbers(graph) == expected);
+
+    const auto core = xgraph::algorithm::ExtractCore(graph, 3);
+    REQUIRE(core.NodeSize() == 4);
+    REQUIRE(core.EdgeSize() == 12);
+    REQUIRE(!core.IsDirected());
+    REQUIRE(core.GetNode(0) == graph.GetNode(3));
+    REQUIRE(core.Index(graph.GetNode(7)) == core.npos);
+    REQUIRE(core.OutNeighbors(core.Index(graph.GetNode(6))).size() == 3);
+  }
+
+  SECTION("Directed degree kinds") {
+    // Star 0 -> {1, 2, 3} plus cycle 1 -> 2 -> 3 -> 1
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < 4; ++i) {
+      graph.AddNode(i);
+    }
+    graph.AddEdge(0, 1);
+    graph.AddEdge(0, 2);
+    graph.AddEdge(0, 3);
+    graph.AddEdge(1, 2);
+    graph.AddEdge(2, 3);
+    graph.AddEdge(3, 1);
+
+    REQUIRE(xgraph::algorithm::CoreNumbers(graph, CoreDegree::Out) ==
+            std::vector<std::size_t>{1, 1, 1, 1});
+    REQUIRE(xgraph::algorithm::CoreNumbers(graph, CoreDegree::In) ==
+            std::vector<std::size_t>{0, 1, 1, 1});
+    REQUIRE(xgraph::algorithm::CoreNumbers(graph, CoreDegree::Total) ==
+            std::vector<std::size_t>{3, 3, 3, 3});
+
+    const auto core = xgraph::algorithm::ExtractCore(graph, 1, CoreDegree::In);
+    REQUIRE(core.NodeSize() == 3);
+    REQUIRE(core.EdgeSize() == 3);
+  }
+
+  SECTION("Random graphs against the definition") {
+    constexpr std::size_t size = 150;
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < size; ++i) {
+      graph.AddNode(i);
+    }
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (std::size_t k = 0; k < 5 * size; ++k) {
+      // Skewed endpoints give a range of core numbers
+      const auto s = static_cast<std::size_t>(unit(rng) * unit(rng) * size);
+      const auto t = rng() % size;
+      if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+        graph.AddEdge(s, t);
+      }
+    }
+    const xgraph::CSRGraph<Node, Edge> csr(graph);
+
+    for (const auto mode :
+         {CoreDegree::In, CoreDegree::Out, CoreDegree::Total}) {
+      const auto expected = NaiveCores(csr, mode);
+      REQUIRE(xgraph::algorithm::CoreNumbers(csr, mode) == expected);
+      for (const auto threads : {std::size_t{1}, std::size_t{4}}) {
+        REQUIRE(xgraph::algorithm::ParallelCoreNumbers(csr, mode, threads) ==
+                expected);
+      }
+    }
+  }
+
+  SECTION("Frontiers large enough for the worker pool") {
+    constexpr std::size_t size = 6000;
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < size; ++i) {
+      graph.AddNode(i);
+    }
+    // A cycle with a few chords, most nodes are peeled in the same rounds
+    std::mt19937 rng(3);
+    for (std::size_t i = 0; i < size; ++i) {
+      graph.AddEdge(i, (i + 1) % size);
+    }
+    for (std::size_t k = 0; k < size / 2; ++k) {
+      const auto s = rng() % size;
+      const auto t = rng() % size;
+      if (s != t) {
+        graph.AddEdge(s, t);
+      }
+    }
+    const xgraph::CSRGraph<Node, Edge> csr(graph);
+    REQUIRE(xgraph::algorithm::ParallelCoreNumbers(csr, CoreDegree::Total,
+                                                   4) ==
+            xgraph::algorithm::CoreNumbers(csr, CoreDegree::Total));
+  }
+}
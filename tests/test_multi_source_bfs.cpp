@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+static constexpr std::size_t N = 200;
+
+static std::vector<std::size_t> Distances(const xgraph::CSRGraph<>& csr,
+                                          const std::size_t source) {
+  std::vector<std::size_t> dist(csr.NodeSize(), xgraph::CSRGraph<>::npos);
+  std::queue<std::size_t> q;
+  dist[source] = 0;
+  q.push(source);
+  while (!q.empty()) {
+    const auto v = q.front();
+    q.pop();
+    for (const auto w : csr.OutNeighbors(v)) {
+      if (dist[w] == xgraph::CSRGraph<>::npos) {
+        dist[w] = dist[v] + 1;
+        q.push(w);
+      }
+    }
+  }
+  return dist;
+}
+
+TEST_CASE("Multi-Source BFS", "CSRGraph") {
+  xgraph::DiGraph<> graph;
+  for (std::size_t i = 0; i < N; ++i) {
+    graph.AddNode(i);
+  }
+  std::mt19937 rng(7);
+  for (std::size_t i = 0; i < 2 * N; ++i) {
+    graph.AddEdge(rng() % N, rng() % N);
+  }
+  const xgraph::CSRGraph csr(graph);
+
+  // More sources than one batch, with duplicates
+  std::vector<std::size_t> sources;
+  for (std::size_t i = 0; i < 150; ++i) {
+    sources.push_back(rng() % N);
+  }
+
+  const auto check = [&](const std::vector<std::size_t>& distances) {
+    REQUIRE(distances.size() == sources.size() * N);
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+      const auto expected = Distances(csr, sources[i]);
+      for (std::size_t v = 0; v < N; ++v) {
+        REQUIRE(distances[i * N + v] == expected[v]);
+      }
+    }
+  };
+  check(xgraph::algorithm::MultiSourceDistances(csr, sources));
+  check(xgraph::algorithm::MultiSourceDistances<128>(csr, sources));
+  check(xgraph::algorithm::MultiSourceDistances<512>(csr, sources));
+
+  // Every (source, node) pair is reported once, in ascending depth
+  std::vector<std::size_t> last_depth(sources.size(), 0);
+  std::size_t pairs{0};
+  std::size_t reachable{0};
+  xgraph::algorithm::MultiSourceBFS<256>(
+      csr, sources,
+      [&](const std::size_t source, const std::size_t, const std::size_t d) {
+        REQUIRE(d >= last_depth[source]);
+        last_depth[source] = d;
+        ++pairs;
+      });
+  for (const auto s : sources) {
+    for (const auto d : Distances(csr, s)) {
+      reachable += d != xgraph::CSRGraph<>::npos;
+    }
+  }
+  REQUIRE(pairs == reachable);
+}
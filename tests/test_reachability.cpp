@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+static constexpr int N = 10;
+
+TEST_CASE("DiGraph Reachability", "DiGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+
+  // Chain 0 -> 1 -> ... -> N-1 with a cycle 3 -> 4 -> 5 -> 3
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  for (int i = 0; i + 1 < N; ++i) {
+    graph->AddEdge(i, i + 1);
+  }
+  graph->AddEdge(5, 3);
+  graph->AddNode("isolated");
+
+  const xgraph::algorithm::ReachabilityIndex index(*graph);
+  REQUIRE(index.IsStale());
+
+  REQUIRE(index.CanReach(0, N - 1));
+  REQUIRE_FALSE(index.CanReach(N - 1, 0));
+  REQUIRE(index.CanReach(4, 3));
+  REQUIRE(index.CanReach(4, 4));
+  REQUIRE_FALSE(index.CanReach(0, 0));
+  REQUIRE_FALSE(index.IsStale());
+  REQUIRE(index.ComponentSize() == N - 2 + 1);
+
+  // Same answers as the traversal based queries
+  for (int i = 0; i < N; ++i) {
+    const auto n = graph->GetNode(i);
+    REQUIRE(index.Descendants(n) == graph->Successor(i));
+    REQUIRE(index.Ancestors(n) == graph->Predecessor(i));
+  }
+  REQUIRE(index.Descendants(graph->GetNode("isolated")).empty());
+
+  // Rebuilt lazily after modification
+  graph->AddEdge(N - 1, 0);
+  REQUIRE(index.IsStale());
+  REQUIRE(index.CanReach(N - 1, 0));
+  REQUIRE(index.CanReach(0, 0));
+  REQUIRE(index.ComponentSize() == 2);
+
+  graph->RemoveNode(N - 1);
+  REQUIRE_FALSE(index.CanReach(N - 2, 0));
+  REQUIRE(index.Descendants(graph->GetNode(0)) == graph->Successor(0));
+}
+
+TEST_CASE("Graph Reachability", "Graph") {
+  const auto graph = std::make_shared<xgraph::Graph<>>();
+
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  for (int i = 0; i + 1 < N / 2; ++i) {
+    graph->AddEdge(i, i + 1);
+  }
+
+  const xgraph::algorithm::ReachabilityIndex index(*graph);
+  REQUIRE(index.CanReach(0, N / 2 - 1));
+  REQUIRE(index.CanReach(N / 2 - 1, 0));
+  REQUIRE_FALSE(index.CanReach(0, N / 2));
+  REQUIRE(index.Descendants(graph->GetNode(0)).size() == N / 2);
+}
+
+TEST_CASE("Reachability Without Closure", "DiGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  for (int i = 0; i + 1 < N; ++i) {
+    graph->AddEdge(i, i + 1);
+  }
+  graph->AddEdge(5, 3);
+
+  // No byte budget: answers come from searches of the snapshot
+  const xgraph::algorithm::ReachabilityIndex index(*graph, 0);
+  const xgraph::algorithm::ReachabilityIndex closure(*graph);
+  REQUIRE_FALSE(index.HasClosure());
+  REQUIRE(closure.HasClosure());
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      REQUIRE(index.CanReach(i, j) == closure.CanReach(i, j));
+    }
+    const auto n = graph->GetNode(i);
+    REQUIRE(index.Descendants(n) == closure.Descendants(n));
+    REQUIRE(index.Ancestors(n) == closure.Ancestors(n));
+  }
+  REQUIRE_FALSE(index.CanReach(0, N));
+}
@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <set>
+#include <tuple>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+using xgraph::algorithm::ReorderStrategy;
+
+static constexpr int N = 40;
+
+TEST_CASE("Reorder", "CSR") {
+  // Two dense clusters joined by one edge, ids interleaved between clusters
+  xgraph::DiGraph<XNode<>, XEdge<XNode<>, xgraph::EmptyObject, int>> graph;
+  for (int i = 0; i < N; ++i) {
+    graph.AddNode(i);
+  }
+  for (int i = 0; i < N; ++i) {
+    for (int j = i % 2; j < N; j += 2) {
+      if (i != j && (i * 7 + j * 3) % 5 != 0) {
+        graph.AddEdge(i, j, i + j);
+      }
+    }
+  }
+  graph.AddEdge(0, 1, 100);
+
+  const xgraph::CSRGraph csr(graph);
+  std::set<std::tuple<std::size_t, std::size_t, int>> arcs;
+  for (std::size_t s = 0; s < csr.NodeSize(); ++s) {
+    const auto row = csr.OutNeighbors(s);
+    for (std::size_t k = 0; k < row.size(); ++k) {
+      arcs.emplace(csr.GetNode(s)->Id(), csr.GetNode(row[k])->Id(),
+                   csr.OutWeights(s)[k]);
+    }
+  }
+
+  for (const auto strategy :
+       std::array{ReorderStrategy::Degree, ReorderStrategy::ReverseCuthillMcKee,
+                  ReorderStrategy::BFS, ReorderStrategy::Community}) {
+    const auto [reordered, permutation] =
+        xgraph::algorithm::Reorder(graph, strategy);
+    REQUIRE(reordered.NodeSize() == csr.NodeSize());
+    REQUIRE(reordered.EdgeSize() == csr.EdgeSize());
+
+    // Permutation is a bijection consistent with the renumbered nodes
+    auto sorted = permutation;
+    std::ranges::sort(sorted);
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+      REQUIRE(sorted[i] == i);
+      REQUIRE(reordered.GetNode(permutation[i]) == csr.GetNode(i));
+      REQUIRE(reordered.Index(csr.GetNode(i)) == permutation[i]);
+    }
+
+    // Same arcs, sorted rows, in rows consistent with out rows
+    std::set<std::tuple<std::size_t, std::size_t, int>> reordered_arcs;
+    for (std::size_t s = 0; s < reordered.NodeSize(); ++s) {
+      const auto row = reordered.OutNeighbors(s);
+      REQUIRE(std::ranges::is_sorted(row));
+      for (std::size_t k = 0; k < row.size(); ++k) {
+        reordered_arcs.emplace(reordered.GetNode(s)->Id(),
+                               reordered.GetNode(row[k])->Id(),
+                               reordered.OutWeights(s)[k]);
+        REQUIRE(std::ranges::binary_search(reordered.InNeighbors(row[k]), s));
+        REQUIRE(reordered.OutEdges(s)[k]->Weight() ==
+                reordered.OutWeights(s)[k]);
+      }
+    }
+    REQUIRE(reordered_arcs == arcs);
+  }
+
+  // Community order keeps each cluster contiguous
+  const auto [clustered, permutation] =
+      xgraph::algorithm::Reorder(csr, ReorderStrategy::Community);
+  std::size_t switches{0};
+  for (std::size_t i = 1; i < clustered.NodeSize(); ++i) {
+    switches += clustered.GetNode(i)->Id() % 2 !=
+                clustered.GetNode(i - 1)->Id() % 2;
+  }
+  REQUIRE(switches == 1);
+
+  // Degree order starts from the hubs
+  const auto by_degree =
+      xgraph::algorithm::Reorder(csr, ReorderStrategy::Degree).graph;
+  for (std::size_t i = 1; i < by_degree.NodeSize(); ++i) {
+    REQUIRE(by_degree.OutDegree(i - 1) + by_degree.InDegree(i - 1) >=
+            by_degree.OutDegree(i) + by_degree.InDegree(i));
+  }
+}
@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <cstdint>
 #include <format>
 #include <ranges>
+#include <stdexcept>
+#include <type_traits>
 
 #include "xgraph"
 
@@ -118,3 +121,209 @@ TEST_CASE("Graph AStar", "Graph") {
           graph->GetNode(std::format("({}, {})", target.first, target.second))),
       std::runtime_error);
 }
+
+TEST_CASE("Unweighted AStar", "DiGraph") {
+  using Edge = XEdge<XNode<>, xgraph::EmptyObject, void>;
+  static_assert(xgraph::IsUnweighted_v<Edge>);
+  static_assert(sizeof(Edge) < sizeof(XEdge<>));
+
+  auto graph = std::make_shared<xgraph::DiGraph<XNode<>, Edge>>();
+  build_graph(*graph, grid_1);
+
+  const auto res = xgraph::algorithm::AStarPath(
+      *graph, graph->GetNode("(0, 0)"), graph->GetNode("(3, 3)"));
+  REQUIRE(res.size() == 7);
+  REQUIRE(res.front()->Name() == "(0, 0)");
+  REQUIRE(res.back()->Name() == "(3, 3)");
+
+  graph = std::make_shared<xgraph::DiGraph<XNode<>, Edge>>();
+  build_graph(*graph, grid_2);
+  REQUIRE_THROWS_AS(xgraph::algorithm::AStarPath(*graph,
+                                                 graph->GetNode("(0, 0)"),
+                                                 graph->GetNode("(2, 2)")),
+                    std::runtime_error);
+}
+
+template <typename Weight> void weighted_shortcut() {
+  using Edge = XEdge<XNode<>, xgraph::EmptyObject, Weight>;
+  static_assert(std::is_same_v<xgraph::EdgeWeight_t<Edge>, Weight>);
+
+  xgraph::DiGraph<XNode<>, Edge> graph;
+  for (int i = 0; i < 4; ++i) {
+    graph.AddNode(i);
+  }
+  graph.AddEdge(0, 3, Weight{10});
+  graph.AddEdge(0, 1, Weight{1});
+  graph.AddEdge(1, 2, Weight{2});
+  graph.AddEdge(2, 3, Weight{3});
+  REQUIRE(graph.HasEdge(0, 3, Weight{10}));
+  REQUIRE_FALSE(graph.HasEdge(0, 3, Weight{1}));
+
+  const auto res = xgraph::algorithm::AStarPath(graph, graph.GetNode(0),
+                                                graph.GetNode(3));
+  REQUIRE(res.size() == 4);
+  REQUIRE(res[1]->Id() == 1);
+
+  const xgraph::CSRGraph csr(graph);
+  static_assert(
+      std::is_same_v<typename decltype(csr.OutWeights(0))::value_type,
+                     Weight>);
+  REQUIRE(csr.OutWeights(csr.Index(0)).front() == Weight{1});
+}
+
+TEST_CASE("Weighted AStar", "DiGraph") {
+  weighted_shortcut<int>();
+  weighted_shortcut<std::uint16_t>();
+  weighted_shortcut<float>();
+  weighted_shortcut<double>();
+
+  using Edge = XEdge<XNode<>, xgraph::EmptyObject, int>;
+  xgraph::DiGraph<XNode<>, Edge> graph;
+  graph.AddNode(0);
+  graph.AddNode(1);
+  graph.AddEdge(0, 1, -1);
+  REQUIRE_THROWS_AS(
+      xgraph::algorithm::AStarPath(graph, graph.GetNode(0), graph.GetNode(1)),
+      std::invalid_argument);
+}
+
+TEST_CASE("Batched AStar", "DiGraph") {
+  using Node = XNode<>;
+  using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+  constexpr std::size_t size = 60;
+
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < size; ++i) {
+    graph.AddNode(i);
+  }
+  for (std::size_t i = 0; i + 1 < size; ++i) {
+    graph.AddEdge(i, i + 1, 1.0 + static_cast<double>(i % 3));
+    if (i + 7 < size) {
+      graph.AddEdge(i, i + 7, 4.5);
+    }
+  }
+  graph.AddNode("isolated");
+
+  std::vector<xgraph::PathQuery_t<Node>> queries;
+  for (std::size_t i = 0; i < size; i += 3) {
+    queries.emplace_back(graph.GetNode(i), graph.GetNode((i + size) / 2));
+  }
+  queries.emplace_back(graph.GetNode(5), graph.GetNode(1));
+  queries.emplace_back(graph.GetNode(0), graph.GetNode("isolated"));
+  queries.emplace_back(graph.GetNode(0), std::make_shared<Node>("missing"));
+
+  const auto cost = [&graph](const auto& path) {
+    double sum{0.0};
+    for (std::size_t k = 1; k < path.size(); ++k) {
+      sum += graph.GetEdge(path[k - 1]->Id(), path[k]->Id(), std::nullopt)
+                 ->Weight();
+    }
+    return sum;
+  };
+
+  // Distance along the chain / 7 shortcuts never overestimates
+  const std::optional<xgraph::Heuristic_t<Node>> heuristic =
+      [](const std::shared_ptr<Node>& n, const std::shared_ptr<Node>& t) {
+        return n->Id() <= t->Id()
+                   ? static_cast<double>(t->Id() - n->Id()) * 4.5 / 7.0 / 2.0
+                   : 0.0;
+      };
+
+  // Batches share one snapshot
+  const xgraph::CSRGraph<Node, Edge> csr(graph);
+  for (const auto threads : {std::size_t{1}, std::size_t{4}}) {
+    for (const auto& h : {std::optional<xgraph::Heuristic_t<Node>>{},
+                          heuristic}) {
+      const auto res = xgraph::algorithm::AStarPaths(csr, queries, h, threads);
+      REQUIRE(res.size() == queries.size());
+
+      for (std::size_t i = 0; i + 3 < queries.size(); ++i) {
+        const auto& [source, target] = queries[i];
+        REQUIRE(res[i].reachable);
+        REQUIRE(res[i].path.front() == source);
+        REQUIRE(res[i].path.back() == target);
+        REQUIRE(res[i].cost == cost(res[i].path));
+        REQUIRE(res[i].cost ==
+                cost(xgraph::algorithm::AStarPath(graph, source, target)));
+      }
+      for (std::size_t i = queries.size() - 3; i < queries.size(); ++i) {
+        REQUIRE_FALSE(res[i].reachable);
+        REQUIRE(res[i].path.empty());
+      }
+    }
+  }
+
+  // The graph overload snapshots the graph itself
+  const auto expected = xgraph::algorithm::AStarPaths(csr, queries);
+  const auto res = xgraph::algorithm::AStarPaths(graph, queries);
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    REQUIRE(res[i].reachable == expected[i].reachable);
+    REQUIRE(res[i].cost == expected[i].cost);
+  }
+}
+
+TEST_CASE("ALT Landmarks", "DiGraph") {
+  using Node = XNode<>;
+  using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+  constexpr std::size_t size = 70;
+
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < size; ++i) {
+    graph.AddNode(i);
+  }
+  for (std::size_t i = 0; i < size; ++i) {
+    graph.AddEdge(i, (i + 1) % size, 1.0 + static_cast<double>(i % 4));
+    graph.AddEdge(i, (i * 7 + 3) % size, 2.5 + static_cast<double>(i % 5));
+  }
+  // Named nodes have large ids, and one is unreachable
+  graph.AddNode("named");
+  graph.AddEdge(graph.GetNode("named")->Id(), 5, 1.0);
+
+  const xgraph::CSRGraph<Node, Edge> csr(graph);
+  std::vector<xgraph::PathQuery_t<Node>> queries;
+  for (std::size_t i = 0; i < size; i += 2) {
+    queries.emplace_back(graph.GetNode(i), graph.GetNode((i * 5 + 11) % size));
+  }
+  queries.emplace_back(graph.GetNode("named"), graph.GetNode(40));
+  queries.emplace_back(graph.GetNode(40), graph.GetNode("named"));
+  const auto expected = xgraph::algorithm::AStarPaths(csr, queries);
+
+  for (const auto selection : {xgraph::algorithm::LandmarkSelection::Farthest,
+                               xgraph::algorithm::LandmarkSelection::Avoid}) {
+    const xgraph::algorithm::Landmarks<Node, Edge> landmarks(csr, 4,
+                                                             selection);
+    REQUIRE(landmarks.Size() == 4);
+
+    // Bounds never exceed the distance
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      const auto& [source, target] = queries[i];
+      if (expected[i].reachable) {
+        REQUIRE(landmarks.Estimate(csr.Index(source), csr.Index(target)) <=
+                expected[i].cost);
+      }
+    }
+
+    const auto res = xgraph::algorithm::AStarPaths(csr, queries, landmarks);
+    const std::optional<xgraph::Heuristic_t<Node>> heuristic =
+        landmarks.Heuristic();
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      REQUIRE(res[i].reachable == expected[i].reachable);
+      REQUIRE(res[i].cost == expected[i].cost);
+      if (expected[i].reachable) {
+        const auto& [source, target] = queries[i];
+        const auto path =
+            xgraph::algorithm::AStarPath(graph, source, target, heuristic);
+        REQUIRE(path.front() == source);
+        REQUIRE(path.back() == target);
+      }
+    }
+    REQUIRE(heuristic.value()(std::make_shared<Node>("missing"),
+                              graph.GetNode(0)) == 0.0);
+  }
+
+  graph.AddNode(size);
+  const xgraph::algorithm::Landmarks<Node, Edge> stale(csr, 2);
+  REQUIRE_THROWS_AS(xgraph::algorithm::AStarPaths(
+                        xgraph::CSRGraph<Node, Edge>(graph), queries, stale),
+                    std::invalid_argument);
+}
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+TEST_CASE("Minimum Spanning Forest", "CSRGraph") {
+  using Node = XNode<>;
+
+  SECTION("Small graph") {
+    using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+
+    // Square 0 1 2 3 with a diagonal, and a separate edge 4 - 5
+    xgraph::Graph<Node, Edge> graph;
+    for (std::size_t i = 0; i < 7; ++i) {
+      graph.AddNode(i);
+    }
+    graph.AddEdge(0, 1, 1.0);
+    graph.AddEdge(1, 2, 2.0);
+    graph.AddEdge(2, 3, 1.0);
+    graph.AddEdge(3, 0, 3.0);
+    graph.AddEdge(0, 2, 2.5);
+    graph.AddEdge(4, 5, 7.0);
+    graph.AddEdge(6, 6, 0.5);
+
+    for (const auto& forest :
+         {xgraph::algorithm::MinimumSpanningForest(graph),
+          xgraph::algorithm::FilterKruskalForest(graph)}) {
+      REQUIRE(forest.weight == 11.0);
+      REQUIRE(forest.edges.size() == 4);
+      REQUIRE(forest.edges.back() == graph.GetEdge(4, 5, std::nullopt));
+      for (const auto& e : forest.edges) {
+        REQUIRE(e != graph.GetEdge(3, 0, std::nullopt));
+        REQUIRE(e != graph.GetEdge(0, 2, std::nullopt));
+      }
+    }
+  }
+
+  SECTION("Directed and unweighted graphs") {
+    using Edge = XEdge<Node>;
+
+    // A cycle 0 -> 1 -> 2 -> 0 and both directions between 2 and 3
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < 4; ++i) {
+      graph.AddNode(i);
+    }
+    graph.AddEdge(0, 1);
+    graph.AddEdge(1, 2);
+    graph.AddEdge(2, 0);
+    graph.AddEdge(2, 3);
+    graph.AddEdge(3, 2);
+
+    const auto forest = xgraph::algorithm::MinimumSpanningForest(graph);
+    REQUIRE(forest.edges.size() == 3);
+    REQUIRE(forest.weight == 3.0);
+    REQUIRE(xgraph::algorithm::FilterKruskalForest(graph).arcs ==
+            forest.arcs);
+  }
+
+  SECTION("Random graphs against Kruskal") {
+    using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+    constexpr std::size_t size = 400;
+
+    std::mt19937 rng(23);
+    for (const auto edge_num : {size / 2, 3 * size}) {
+      xgraph::Graph<Node, Edge> graph;
+      for (std::size_t i = 0; i < size; ++i) {
+        graph.AddNode(i);
+      }
+      for (std::size_t k = 0; k < edge_num; ++k) {
+        const auto s = rng() % size;
+        const auto t = rng() % size;
+        if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+          // Few distinct weights, many ties
+          graph.AddEdge(s, t, static_cast<double>(rng() % 8));
+        }
+      }
+      const xgraph::CSRGraph<Node, Edge> csr(graph);
+
+      // Plain Kruskal with a sequential union-find
+      std::vector<std::size_t> parent(size);
+      std::iota(parent.begin(), parent.end(), 0);
+      const auto find = [&parent](std::size_t v) {
+        while (parent[v] != v) {
+          v = parent[v];
+        }
+        return v;
+      };
+      std::vector<std::pair<double, std::size_t>> arcs;
+      for (std::size_t s = 0; s < size; ++s) {
+        for (std::size_t k = 0; k < csr.OutDegree(s); ++k) {
+          if (s < csr.OutNeighbors(s)[k]) {
+            arcs.emplace_back(csr.OutWeights(s)[k], csr.OutOffset(s) + k);
+          }
+        }
+      }
+      std::ranges::sort(arcs);
+      double expected{0.0};
+      std::size_t expected_size{0};
+      for (const auto& [w, arc] : arcs) {
+        std::size_t s{0};
+        while (csr.OutOffset(s + 1) <= arc) {
+          ++s;
+        }
+        const auto a = find(s);
+        const auto b = find(csr.OutNeighbors(s)[arc - csr.OutOffset(s)]);
+        if (a != b) {
+          parent[a] = b;
+          expected += w;
+          ++expected_size;
+        }
+      }
+
+      const auto kruskal = xgraph::algorithm::FilterKruskalForest(csr);
+      REQUIRE(kruskal.weight == expected);
+      REQUIRE(kruskal.edges.size() == expected_size);
+      for (const auto threads : {std::size_t{1}, std::size_t{4}}) {
+        const auto boruvka =
+            xgraph::algorithm::MinimumSpanningForest(csr, threads);
+        REQUIRE(boruvka.weight == expected);
+        REQUIRE(boruvka.arcs == kruskal.arcs);
+        REQUIRE(boruvka.edges == kruskal.edges);
+      }
+    }
+  }
+
+  SECTION("Stress many threads on the union-find") {
+    using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+    constexpr std::size_t size = 20000;
+
+    // Several blocks of edges per round, so finds and unions race
+    std::mt19937 rng(29);
+    for (std::size_t round = 0; round < 4; ++round) {
+      xgraph::Graph<Node, Edge> graph;
+      for (std::size_t i = 0; i < size; ++i) {
+        graph.AddNode(i);
+      }
+      for (std::size_t k = 0; k < 3 * size; ++k) {
+        const auto s = rng() % size;
+        const auto t = rng() % size;
+        if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+          graph.AddEdge(s, t, static_cast<double>(rng() % 64));
+        }
+      }
+      const xgraph::CSRGraph<Node, Edge> csr(graph);
+      const auto kruskal = xgraph::algorithm::FilterKruskalForest(csr);
+      const auto boruvka = xgraph::algorithm::MinimumSpanningForest(csr, 8);
+      REQUIRE(boruvka.weight == kruskal.weight);
+      REQUIRE(boruvka.arcs == kruskal.arcs);
+    }
+  }
+}
@@ -1,4 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "xgraph"
@@ -192,3 +197,437 @@ TEST_CASE("Graph Structure", "Graph") {
   REQUIRE(graph->Neighbors("target").contains(s_node));
   REQUIRE(graph->Neighbors("0").size() == N - 1);
 }
+
+TEST_CASE("CSR Structure", "CSRGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  for (int i = 0; i < N; ++i) {
+    graph->AddEdge(i, (i + 1) % N, 1.0 + i);
+    graph->AddEdge(i, (i + 2) % N);
+  }
+
+  const xgraph::CSRGraph csr(*graph);
+  REQUIRE(csr.IsDirected());
+  REQUIRE(csr.Version() == graph->Version());
+  REQUIRE(csr.NodeSize() == N);
+  REQUIRE(csr.EdgeSize() == 2 * N);
+
+  const auto zero = csr.Index(0);
+  REQUIRE(csr.GetNode(zero)->Id() == 0);
+  REQUIRE(csr.Index(N) == xgraph::CSRGraph<>::npos);
+  REQUIRE(csr.OutDegree(zero) == 2);
+  REQUIRE(csr.InDegree(zero) == 2);
+  REQUIRE(std::ranges::is_sorted(csr.OutNeighbors(zero)));
+
+  const auto one = csr.Index(1);
+  REQUIRE(csr.OutNeighbors(zero).front() == one);
+  REQUIRE(csr.OutWeights(zero).front() == 1.0);
+  REQUIRE(csr.OutEdges(zero).front()->Target()->Id() == 1);
+
+  // Undirected graphs store both directions
+  const auto u_graph = std::make_shared<xgraph::Graph<>>();
+  u_graph->AddNode(0);
+  u_graph->AddNode(1);
+  u_graph->AddEdge(0, 1);
+
+  const xgraph::CSRGraph u_csr(*u_graph);
+  REQUIRE_FALSE(u_csr.IsDirected());
+  REQUIRE(u_csr.EdgeSize() == 2);
+  REQUIRE(u_csr.OutDegree(u_csr.Index(1)) == 1);
+
+  // Edges must join nodes of the graph
+  const auto outside = std::make_shared<XNode<>>(std::size_t{N});
+  graph->AddEdge(std::make_shared<XEdge<>>(
+      std::weak_ptr<XNode<>>(graph->GetNode(0)),
+      std::weak_ptr<XNode<>>(outside)));
+  REQUIRE_THROWS_AS(xgraph::CSRGraph(*graph), std::invalid_argument);
+}
+
+TEST_CASE("DiGraph Query Cache", "DiGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  for (int i = 0; i + 1 < N; ++i) {
+    graph->AddEdge(i, i + 1);
+  }
+
+  // Every effective modification bumps the version
+  auto version = graph->Version();
+  graph->AddEdge(0, 1);
+  REQUIRE(graph->Version() == version);
+  graph->AddNode("extra");
+  REQUIRE(graph->Version() == ++version);
+  graph->RemoveNode("extra");
+  REQUIRE(graph->Version() == ++version);
+
+  REQUIRE(graph->QueryCacheStats().hits == 0);
+  graph->EnableQueryCache(4);
+
+  const auto successors = graph->Successor(0);
+  REQUIRE(successors.size() == N - 1);
+  // The walk itself stays out of the cache
+  REQUIRE(graph->QueryCacheStats().misses == 1);
+  REQUIRE(graph->QueryCacheStats().evictions == 0);
+
+  REQUIRE(graph->Successor("0") == successors);
+  for (int i = 0; i < N; ++i) {
+    REQUIRE(graph->Successor(0) == successors);
+  }
+  const auto stats = graph->QueryCacheStats();
+  REQUIRE(stats.misses == 1);
+  REQUIRE(stats.hits == N + 1);
+  REQUIRE(static_cast<double>(stats.hits) / (stats.hits + stats.misses) >
+          0.9);
+
+  // Invalidated by modification
+  graph->AddNode(N);
+  graph->AddEdge(N - 1, N);
+  REQUIRE(graph->Successor(0).size() == N);
+  REQUIRE(graph->QueryCacheStats().invalidations == 1);
+  REQUIRE(graph->Children(N - 1).contains(graph->GetNode(N)));
+
+  graph->DisableQueryCache();
+  REQUIRE(graph->QueryCacheStats().misses == 0);
+  REQUIRE(graph->Parents(N).size() == 1);
+}
+
+TEST_CASE("DiGraph Mutation Batch", "DiGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  graph->AddEdge(0, 1);
+  graph->AddEdge(0, 2);
+
+  // Removing one edge keeps the rest of the source's row
+  graph->RemoveEdge(0, 1);
+  REQUIRE(graph->OutEdges(0).size() == 1);
+  REQUIRE(graph->Children(0).contains(graph->GetNode(2)));
+
+  xgraph::MutationBatch<> batch;
+  for (int i = 1; i + 1 < N; ++i) {
+    batch.AddEdge(i, i + 1);
+  }
+  batch.AddEdge(0, N - 1);
+  batch.RemoveEdge(0, N - 1); // cancels the addition
+  batch.RemoveEdge(0, 2);
+  batch.AddEdge(0, N);        // missing target
+  batch.AddEdge(N - 1, 0, 2.0);
+  REQUIRE(batch.Size() == N + 3);
+
+  const auto version = graph->Version();
+  REQUIRE(graph->Apply(batch) == N);
+  REQUIRE(batch.Empty());
+  REQUIRE(graph->Version() == version + 1);
+
+  REQUIRE(graph->Edges().size() == N - 1);
+  REQUIRE(graph->OutEdges(0).empty());
+  REQUIRE(graph->GetEdge(N - 1, 0, 2.0) != nullptr);
+  REQUIRE(graph->Successor(1).size() == N - 1);
+  REQUIRE(graph->Parents(N - 1).size() == 1);
+
+  // Removal then re-addition of the same edge keeps it
+  batch.RemoveEdge(1, 2);
+  batch.AddEdge(1, 2);
+  batch.RemoveEdge(N - 1, 0, 2.0);
+  REQUIRE(graph->Apply(batch) == 1);
+  REQUIRE(graph->HasEdge(1, 2));
+  REQUIRE(graph->Children(N - 1).empty());
+}
+
+TEST_CASE("Graph Mutation Batch", "Graph") {
+  const auto graph = std::make_shared<xgraph::Graph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+
+  xgraph::MutationBatch<> batch;
+  batch.AddEdge(0, 1);
+  batch.AddEdge(2, 1);
+  batch.RemoveEdge(1, 2); // same undirected edge
+  REQUIRE(graph->Apply(batch) == 1);
+  REQUIRE(graph->Edges().size() == 1);
+  REQUIRE(graph->Neighbors(1).size() == 1);
+
+  batch.RemoveEdge(1, 0);
+  REQUIRE(graph->Apply(batch) == 1);
+  REQUIRE(graph->Edges().empty());
+  REQUIRE(graph->Neighbors(0).empty());
+}
+
+TEST_CASE("DiGraph Node Names", "DiGraph") {
+  xgraph::DiGraph<> graph;
+  graph.AddNode(0, "shared");
+  graph.AddNode(1, "shared");
+  graph.AddNode(2, std::string("other"));
+
+  // Name lookups take views, no string is built
+  const std::string_view name = "shared";
+  REQUIRE(graph.GetNode(name)->Id() == 1);
+  REQUIRE(graph.GetNode(2)->Name() == "other");
+  REQUIRE(graph.HasNode(std::string_view("other")));
+
+  // Removing the former owner keeps the name of the current one
+  graph.RemoveNode(0);
+  REQUIRE(graph.GetNode(name)->Id() == 1);
+  graph.RemoveNode(name);
+  REQUIRE_FALSE(graph.HasNode(name));
+  REQUIRE(graph.NodeSize() == 1);
+}
+
+TEST_CASE("CSR Columns", "CSRGraph") {
+  using Node = XNode<int>;
+  using Edge = XEdge<Node, int>;
+  const auto graph = std::make_shared<xgraph::DiGraph<Node, Edge>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i, std::to_string(i), i * i);
+  }
+  for (int i = 0; i + 1 < N; ++i) {
+    graph->AddEdge(i, i + 1, 1.0, i);
+  }
+
+  // Const data is read in place
+  const auto& node = *graph->GetNode(3);
+  REQUIRE(&node.Data() == &node.Data());
+
+  const xgraph::CSRGraph csr(*graph);
+  const auto squares = csr.NodeColumn([](const Node& n) { return n.Data(); });
+  const auto labels = csr.EdgeColumn([](const Edge& e) { return e.Data(); });
+  REQUIRE(squares.size() == N);
+  REQUIRE(labels.size() == N - 1);
+  REQUIRE(squares[csr.Index(3)] == 9);
+
+  int sum{0};
+  for (const auto label : labels) {
+    sum += label;
+  }
+  REQUIRE(sum == (N - 2) * (N - 1) / 2);
+
+  const auto two = csr.Index(2);
+  REQUIRE(csr.OutRow(labels, two).size() == csr.OutDegree(two));
+  REQUIRE(csr.OutRow(labels, two).front() == 2);
+  REQUIRE(labels[csr.OutOffset(two)] == 2);
+}
+
+TEST_CASE("Edge Lookup", "DiGraph") {
+  xgraph::DiGraph<> graph;
+  for (int i = 0; i < 3; ++i) {
+    graph.AddNode(i);
+  }
+  graph.AddEdge(0, 1, 2.0);
+  graph.AddEdge(0, 1, 3.0); // parallel edge, linked in the row
+  graph.AddEdge(1, 2);
+
+  REQUIRE(graph.GetEdge(0, 1, 3.0)->Weight() == 3.0);
+  REQUIRE(graph.GetEdge(0, 1, 2.0)->Weight() == 2.0);
+  REQUIRE(graph.HasEdge(0, 1, std::nullopt));
+  REQUIRE(graph.HasEdge("1", "2"));
+  REQUIRE_FALSE(graph.HasEdge(0, 1));
+  REQUIRE_FALSE(graph.HasEdge(1, 0, std::nullopt));
+  REQUIRE_FALSE(graph.HasEdge("0", "9", std::nullopt));
+
+  graph.RemoveEdge(0, 1, 3.0);
+  REQUIRE(graph.Edges().size() == 2);
+  REQUIRE_FALSE(graph.HasEdge(0, 1, 3.0));
+
+  // The surviving parallel edge takes over the rows
+  REQUIRE(graph.HasEdge(0, 1, 2.0));
+  REQUIRE(graph.HasEdge(0, 1, std::nullopt));
+  REQUIRE(graph.Children(0).contains(graph.GetNode(1)));
+  REQUIRE(graph.Parents(1).contains(graph.GetNode(0)));
+  graph.RemoveEdge(0, 1, 2.0);
+  REQUIRE_FALSE(graph.HasEdge(0, 1, std::nullopt));
+  REQUIRE(graph.Children(0).empty());
+
+  // A shadowed edge removed from the middle leaves the others in order
+  graph.AddEdge(0, 1, 2.0);
+  graph.AddEdge(0, 1, 3.0);
+  graph.AddEdge(0, 1, 4.0);
+  graph.RemoveEdge(0, 1, 3.0);
+  REQUIRE(graph.GetEdge(0, 1, std::nullopt)->Weight() == 4.0);
+  graph.RemoveEdge(0, 1, 4.0);
+  REQUIRE(graph.GetEdge(0, 1, std::nullopt)->Weight() == 2.0);
+
+  // Removing a node removes its parallel edges too
+  graph.AddEdge(0, 1, 3.0);
+  graph.AddEdge(0, 1, 4.0);
+  graph.AddEdge(2, 0, 5.0);
+  graph.AddEdge(2, 0, 6.0);
+  graph.AddEdge(0, 0);
+  graph.AddEdge(0, 0, 2.0);
+  graph.RemoveNode(0);
+  REQUIRE(graph.Edges().size() == 1);
+  REQUIRE(graph.Children(2).empty());
+  REQUIRE(graph.Parents(1).empty());
+
+  // Undirected lookups match both directions
+  xgraph::Graph<> u_graph;
+  u_graph.AddNode(0);
+  u_graph.AddNode(1);
+  u_graph.AddEdge(0, 1, 5.0);
+  REQUIRE(u_graph.HasEdge(1, 0, 5.0));
+  REQUIRE(u_graph.GetEdge(1, 0, std::nullopt)->Source()->Id() == 0);
+  REQUIRE_FALSE(u_graph.HasEdge(1, 0));
+
+  const xgraph::CSRGraph csr(graph);
+  const auto one = csr.Index(1);
+  const auto two = csr.Index(2);
+  REQUIRE(csr.FindArc(one, two) == csr.OutOffset(one));
+  REQUIRE(csr.FindArc(two, one) == xgraph::CSRGraph<>::npos);
+}
+
+TEST_CASE("DiGraph Removal and Compaction", "DiGraph") {
+  xgraph::DiGraph<> graph;
+  for (int i = 0; i < N; ++i) {
+    graph.AddNode(i);
+  }
+  for (int i = 1; i < N; ++i) {
+    graph.AddEdge(0, i);
+    graph.AddEdge(i, 0);
+  }
+  REQUIRE(graph.Slot(3) == 3);
+  REQUIRE(graph.InEdges(0).size() == N - 1);
+
+  graph.RemoveNode(1);
+  graph.RemoveNode("2");
+  REQUIRE(graph.NodeSize() == N - 2);
+  REQUIRE(graph.EdgeSize() == 2 * (N - 3));
+  REQUIRE(graph.InEdges(0).size() == N - 3);
+  REQUIRE(graph.OutEdges(0).size() == N - 3);
+  REQUIRE_FALSE(graph.HasEdge(0, 1));
+  REQUIRE(graph.GetNode(1) == nullptr);
+  REQUIRE(graph.Slot(1) == xgraph::DiGraph<>::npos);
+
+  // Removed slots are tombstoned until compaction
+  REQUIRE(graph.SlotSize() == N);
+  REQUIRE(graph.NodeAt(1) == nullptr);
+  REQUIRE(graph.Fragmentation().tombstones == 2);
+  REQUIRE(graph.Fragmentation().Ratio() == 2.0 / N);
+
+  REQUIRE(graph.Compact() == 2);
+  REQUIRE(graph.SlotSize() == N - 2);
+  REQUIRE(graph.Fragmentation().Ratio() == 0.0);
+  REQUIRE(graph.Slot(3) == 1);
+  REQUIRE(graph.NodeAt(graph.Slot(N - 1))->Id() == N - 1);
+  REQUIRE(graph.GetNode(3)->Id() == 3);
+  REQUIRE(graph.Children(3).contains(graph.GetNode(0)));
+}
+
+TEST_CASE("Compressed Adjacency", "CompressedGraph") {
+  // Similar neighborhoods with long gaps to exercise references and codecs
+  xgraph::DiGraph<> graph;
+  constexpr int size = 300;
+  for (int i = 0; i < size; ++i) {
+    graph.AddNode(i * 1000);
+  }
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; j += 1 + (i + j) % 5) {
+      if (j % 7 != i % 7) {
+        graph.AddEdge(i * 1000, j * 1000);
+      }
+    }
+    graph.AddEdge(i * 1000, (size - 1 - i) * 1000);
+  }
+  graph.AddEdge(0, 0);
+
+  const xgraph::CSRGraph csr(graph);
+  for (const auto codec :
+       {xgraph::AdjacencyCodec::Varint, xgraph::AdjacencyCodec::StreamVByte}) {
+    for (const std::size_t window : {0, 7}) {
+      const xgraph::CompressedGraph compressed(csr, codec, window);
+      REQUIRE(compressed.NodeSize() == csr.NodeSize());
+      REQUIRE(compressed.EdgeSize() == csr.EdgeSize());
+      REQUIRE(compressed.ByteSize() <
+              csr.EdgeSize() * sizeof(std::size_t));
+
+      for (std::size_t i = 0; i < csr.NodeSize(); ++i) {
+        REQUIRE(compressed.GetNode(i) == csr.GetNode(i));
+        REQUIRE(compressed.Index(csr.GetNode(i)) == i);
+        REQUIRE(compressed.OutDegree(i) == csr.OutDegree(i));
+
+        const auto out = compressed.OutNeighbors(i);
+        REQUIRE(out.size() == csr.OutDegree(i));
+        REQUIRE(std::ranges::equal(out, csr.OutNeighbors(i)));
+        REQUIRE(std::ranges::equal(compressed.InNeighbors(i),
+                                   csr.InNeighbors(i)));
+      }
+    }
+  }
+
+  // References shrink lists that repeat their predecessors
+  REQUIRE(xgraph::CompressedGraph(csr, xgraph::AdjacencyCodec::Varint, 7)
+              .ByteSize() <
+          xgraph::CompressedGraph(csr, xgraph::AdjacencyCodec::Varint)
+              .ByteSize());
+
+  // Undirected graphs reuse the out lists
+  xgraph::Graph<> u_graph;
+  u_graph.AddNode(0);
+  u_graph.AddNode(1);
+  u_graph.AddEdge(0, 1);
+  const xgraph::CompressedGraph u_compressed(u_graph);
+  REQUIRE_FALSE(u_compressed.IsDirected());
+  REQUIRE(std::ranges::equal(u_compressed.InNeighbors(0),
+                             std::vector<std::size_t>{1}));
+}
+
+TEST_CASE("Compressed Streaming and Serialization", "CompressedGraph") {
+  xgraph::DiGraph<> graph;
+  constexpr int size = 200;
+  for (int i = 0; i < size; ++i) {
+    graph.AddNode(i);
+  }
+  for (int i = 0; i < size; ++i) {
+    for (int j = i % 3; j < size; j += 2 + i % 5) {
+      graph.AddEdge(i, j);
+    }
+  }
+  const xgraph::CSRGraph csr(graph);
+
+  std::vector<std::shared_ptr<XNode<>>> nodes;
+  std::vector<std::pair<std::size_t, std::size_t>> out;
+  std::vector<std::pair<std::size_t, std::size_t>> in;
+  for (std::size_t i = 0; i < csr.NodeSize(); ++i) {
+    nodes.push_back(csr.GetNode(i));
+    for (const auto t : csr.OutNeighbors(i)) {
+      out.emplace_back(i, t);
+    }
+    for (const auto s : csr.InNeighbors(i)) {
+      in.emplace_back(i, s);
+    }
+  }
+
+  const xgraph::CompressedGraph expected(csr, xgraph::AdjacencyCodec::Varint,
+                                         3);
+  const auto streamed = xgraph::CompressedGraph<>::FromSortedArcs(
+      nodes, out, in, xgraph::AdjacencyCodec::Varint, 3);
+  REQUIRE(streamed.EdgeSize() == csr.EdgeSize());
+  REQUIRE(streamed.ByteSize() == expected.ByteSize());
+
+  std::stringstream buffer;
+  streamed.Save(buffer);
+  const auto loaded = xgraph::CompressedGraph<>::Load(buffer, graph);
+  for (const auto& g : {std::cref(streamed), std::cref(loaded)}) {
+    REQUIRE(g.get().NodeSize() == csr.NodeSize());
+    for (std::size_t i = 0; i < csr.NodeSize(); ++i) {
+      REQUIRE(g.get().GetNode(i) == csr.GetNode(i));
+      REQUIRE(std::ranges::equal(g.get().OutNeighbors(i),
+                                 csr.OutNeighbors(i)));
+      REQUIRE(std::ranges::equal(g.get().InNeighbors(i),
+                                 csr.InNeighbors(i)));
+    }
+  }
+
+  // Unsorted streams and foreign nodes are rejected
+  std::ranges::swap(out[0], out[1]);
+  REQUIRE_THROWS_AS(xgraph::CompressedGraph<>::FromSortedArcs(nodes, out, in),
+                    std::invalid_argument);
+  buffer.clear();
+  buffer.seekg(0);
+  nodes.pop_back();
+  REQUIRE_THROWS_AS(xgraph::CompressedGraph<>::Load(buffer, nodes),
+                    std::runtime_error);
+}
@@ -1,4 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
 
 #include "xgraph"
 
@@ -150,3 +155,308 @@ TEST_CASE("Graph BFS", "Graph") {
   xgraph::algorithm::BFS(*graph, graph->GetNode(0), add_visitor);
   REQUIRE(res.size() == 10);
 }
+
+TEST_CASE("Compressed BFS and DFS", "CompressedGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < 4 * N; ++i) {
+    graph->AddNode(i);
+  }
+  for (int i = 0; i < 2 * N; ++i) {
+    graph->AddEdge(i, (i * 3 + 1) % (2 * N));
+  }
+  // Reached through a parent only
+  graph->AddEdge(3 * N, 0);
+
+  std::vector<std::shared_ptr<XNode<>>> res{};
+  const std::optional<xgraph::NodePtrVisitor_t<XNode<>>> add_visitor =
+      [&res](const std::shared_ptr<XNode<>>& node_ptr) {
+        res.push_back(node_ptr);
+      };
+  const auto ids = [&res] {
+    std::vector<std::size_t> ids;
+    for (const auto& n : res) {
+      ids.push_back(n->Id());
+    }
+    std::ranges::sort(ids);
+    return ids;
+  };
+
+  xgraph::algorithm::BFS(*graph, graph->GetNode(0), add_visitor);
+  const auto expected = ids();
+  REQUIRE(std::ranges::find(expected, 3 * N) != expected.end());
+
+  for (const auto codec :
+       {xgraph::AdjacencyCodec::Varint, xgraph::AdjacencyCodec::StreamVByte}) {
+    const xgraph::CompressedGraph compressed(*graph, codec, 3);
+
+    res.clear();
+    xgraph::algorithm::BFS(compressed, graph->GetNode(0), add_visitor);
+    REQUIRE(res.front()->Id() == 0);
+    REQUIRE(ids() == expected);
+
+    res.clear();
+    xgraph::algorithm::DFS(compressed, graph->GetNode(0), add_visitor);
+    REQUIRE(res.front()->Id() == 0);
+    REQUIRE(ids() == expected);
+  }
+}
+
+TEST_CASE("Traversal Visited Set Reuse", "DiGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  for (int i = 0; i + 1 < N; ++i) {
+    graph->AddEdge(i, i + 1);
+  }
+
+  std::vector<std::size_t> res{};
+  const std::optional<xgraph::NodePtrVisitor_t<XNode<>>> add_visitor =
+      [&res](const std::shared_ptr<XNode<>>& node_ptr) {
+        res.push_back(node_ptr->Id());
+      };
+
+  xgraph::utils::VisitedSet visited;
+  for (int round = 0; round < 3; ++round) {
+    res.clear();
+    xgraph::algorithm::BFS(*graph, graph->GetNode(0), visited, add_visitor);
+    REQUIRE(res.size() == N);
+    REQUIRE(std::ranges::is_sorted(res));
+
+    res.clear();
+    xgraph::algorithm::DFS(*graph, graph->GetNode(N - 1), visited,
+                           add_visitor);
+    REQUIRE(res.size() == N);
+    REQUIRE(std::ranges::is_sorted(res, std::ranges::greater{}));
+  }
+  const auto capacity = visited.Capacity();
+
+  // Removed slots stay allocated, new nodes grow the set
+  graph->RemoveNode(N / 2);
+  res.clear();
+  xgraph::algorithm::BFS(*graph, graph->GetNode(0), visited, add_visitor);
+  REQUIRE(res.size() == N / 2);
+  REQUIRE(visited.Capacity() == capacity);
+
+  graph->AddNode(N);
+  graph->AddEdge(0, N);
+  res.clear();
+  xgraph::algorithm::BFS(*graph, graph->GetNode(0), visited, add_visitor);
+  REQUIRE(res.size() == N / 2 + 1);
+  REQUIRE(visited.Capacity() == capacity + 1);
+
+  // Undirected graphs are traversed in place, keyed by their own slots
+  xgraph::Graph<> u_graph;
+  for (int i = 0; i < N; ++i) {
+    u_graph.AddNode(i);
+  }
+  for (int i = 0; i + 1 < N; ++i) {
+    u_graph.AddEdge(i, i + 1);
+  }
+  u_graph.RemoveNode(0);
+  res.clear();
+  xgraph::algorithm::DFS(u_graph, u_graph.GetNode(N - 1), visited,
+                         add_visitor);
+  REQUIRE(res.size() == N - 1);
+  REQUIRE(std::ranges::is_sorted(res, std::ranges::greater{}));
+  REQUIRE_FALSE(visited.Contains(0));
+  for (int i = 1; i < N; ++i) {
+    REQUIRE(visited.Contains(u_graph.Slot(i)));
+  }
+}
+
+TEST_CASE("Traversal Start Not in Graph", "DiGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  for (int i = 0; i + 1 < N; ++i) {
+    graph->AddEdge(i, i + 1);
+  }
+  const auto outside = std::make_shared<XNode<>>(std::size_t{N});
+
+  std::size_t visits{0};
+  const std::optional<xgraph::NodePtrVisitor_t<XNode<>>> count_visitor =
+      [&visits](const std::shared_ptr<XNode<>>&) { ++visits; };
+
+  xgraph::utils::VisitedSet visited;
+  xgraph::algorithm::BFS(*graph, outside, visited, count_visitor);
+  xgraph::algorithm::DFS(*graph, outside, visited, count_visitor);
+
+  const xgraph::CompressedGraph compressed(*graph);
+  xgraph::algorithm::BFS(compressed, outside, count_visitor);
+  xgraph::algorithm::DFS(compressed, outside, count_visitor);
+  REQUIRE(visits == 0);
+
+  const auto count = [&visits](const std::shared_ptr<XNode<>>&) {
+    ++visits;
+    return xgraph::VisitControl::Continue;
+  };
+  REQUIRE_FALSE(xgraph::algorithm::BFS(*graph, outside, count));
+  REQUIRE_FALSE(xgraph::algorithm::DFS(*graph, outside, count));
+  REQUIRE(visits == 0);
+}
+
+#if defined(__cpp_lib_generator)
+TEST_CASE("Lazy Traversal", "DiGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  // Binary tree 0 -> {1, 2}, 1 -> {3, 4}, ...
+  for (int i = 1; i < N; ++i) {
+    graph->AddEdge((i - 1) / 2, i);
+  }
+
+  // Only the consumed prefix is visited
+  std::vector<std::size_t> depths;
+  for (const auto& step :
+       xgraph::algorithm::LazyBFS(*graph, graph->GetNode(0)) |
+           std::views::take(3)) {
+    depths.push_back(step.depth);
+    if (step.parent) {
+      REQUIRE(step.parent->Id() == (step.node->Id() - 1) / 2);
+      REQUIRE(step.edge->Target() == step.node);
+    } else {
+      REQUIRE(step.node->Id() == 0);
+      REQUIRE_FALSE(step.edge);
+    }
+  }
+  REQUIRE(depths == std::vector<std::size_t>{0, 1, 1});
+
+  // Neighbors are followed in both directions like `BFS`
+  std::size_t size{0};
+  for (const auto& step :
+       xgraph::algorithm::LazyDFS(*graph, graph->GetNode(N - 1))) {
+    REQUIRE(graph->HasNode(step.node->Id()));
+    ++size;
+  }
+  REQUIRE(size == N);
+
+  // Stop at a predicate
+  std::size_t found{N};
+  for (const auto& step :
+       xgraph::algorithm::LazyDFS(*graph, graph->GetNode(0))) {
+    if (step.depth == 2) {
+      found = step.node->Id();
+      break;
+    }
+  }
+  REQUIRE(found >= 3);
+  REQUIRE(found <= 6);
+
+  // Parents come before children
+  std::vector<std::size_t> position(N, N);
+  std::size_t index{0};
+  for (const auto& step : xgraph::algorithm::LazyTopologicalSort(*graph)) {
+    position[step.node->Id()] = index++;
+    REQUIRE(step.depth == static_cast<std::size_t>(
+                              std::bit_width(step.node->Id() + 1) - 1));
+  }
+  for (int i = 1; i < N; ++i) {
+    REQUIRE(position[(i - 1) / 2] < position[i]);
+  }
+
+  graph->AddEdge(N - 1, 0);
+  const auto cyclic = [&graph] {
+    for ([[maybe_unused]] const auto& step :
+         xgraph::algorithm::LazyTopologicalSort(*graph)) {
+    }
+  };
+  REQUIRE_THROWS_AS(cyclic(), std::runtime_error);
+
+  // Nothing is yielded from a start node that is not in the graph
+  const auto outside = std::make_shared<XNode<>>(std::size_t{N});
+  REQUIRE(std::ranges::distance(
+              xgraph::algorithm::LazyBFS(*graph, outside)) == 0);
+  REQUIRE(std::ranges::distance(
+              xgraph::algorithm::LazyDFS(*graph, outside)) == 0);
+}
+#endif
+
+TEST_CASE("Traversal Visitor Control", "DiGraph") {
+  const auto graph = std::make_shared<xgraph::DiGraph<>>();
+  for (int i = 0; i < N; ++i) {
+    graph->AddNode(i);
+  }
+  // Binary tree 0 -> {1, 2}, 1 -> {3, 4}, ...
+  for (int i = 1; i < N; ++i) {
+    graph->AddEdge((i - 1) / 2, i);
+  }
+  using xgraph::VisitControl;
+  using NodePtr = std::shared_ptr<XNode<>>;
+  using EdgePtr = std::shared_ptr<XEdge<>>;
+
+  // Stop as soon as the target is found
+  std::size_t visited{0};
+  REQUIRE(xgraph::algorithm::BFS(*graph, graph->GetNode(0),
+                                 [&visited](const NodePtr& n) {
+                                   ++visited;
+                                   return n->Id() == 2 ? VisitControl::Stop
+                                                       : VisitControl::Continue;
+                                 }));
+  REQUIRE(visited == 3);
+
+  // Prune the subtree of 1 and the edge into 6
+  struct Pruner {
+    std::vector<std::size_t> discovered;
+    std::size_t examined{0};
+
+    VisitControl DiscoverNode(const NodePtr& n) {
+      discovered.push_back(n->Id());
+      return n->Id() == 1 ? VisitControl::SkipChildren
+                          : VisitControl::Continue;
+    }
+
+    VisitControl ExamineEdge(const EdgePtr& e) {
+      ++examined;
+      return e->Target()->Id() == 6 ? VisitControl::SkipChildren
+                                    : VisitControl::Continue;
+    }
+  } pruner;
+  REQUIRE_FALSE(xgraph::algorithm::BFS(*graph, graph->GetNode(0), pruner));
+  std::ranges::sort(pruner.discovered);
+  REQUIRE(pruner.discovered == std::vector<std::size_t>{0, 1, 2, 5});
+  REQUIRE(pruner.examined == 2 + 3 + 1);
+
+  // Finish order of depth first search is a post order
+  struct Recorder {
+    std::vector<std::size_t> discovered;
+    std::vector<std::size_t> finished;
+
+    void DiscoverNode(const NodePtr& n) { discovered.push_back(n->Id()); }
+    void FinishNode(const NodePtr& n) { finished.push_back(n->Id()); }
+  } recorder;
+  REQUIRE_FALSE(xgraph::algorithm::DFS(*graph, graph->GetNode(0), recorder));
+  REQUIRE(recorder.discovered.front() == 0);
+  REQUIRE(recorder.finished.back() == 0);
+  REQUIRE(recorder.finished.size() == N);
+  for (int i = 1; i < N; ++i) {
+    const auto finish = [&recorder](const std::size_t id) {
+      return std::ranges::find(recorder.finished, id);
+    };
+    REQUIRE(finish(i) < finish((i - 1) / 2));
+  }
+
+  // Stop from the finish hook
+  struct Stopper {
+    std::size_t finished{0};
+    VisitControl FinishNode(const NodePtr&) {
+      return ++finished == 2 ? VisitControl::Stop : VisitControl::Continue;
+    }
+  } stopper;
+  REQUIRE(xgraph::algorithm::DFS(*graph, graph->GetNode(0), stopper));
+  REQUIRE(stopper.finished == 2);
+
+  // Undirected graphs examine each edge once per endpoint
+  xgraph::Graph<> u_graph;
+  u_graph.AddNode(0);
+  u_graph.AddNode(1);
+  u_graph.AddEdge(0, 1);
+  struct Counter {
+    std::size_t examined{0};
+    void ExamineEdge(const EdgePtr&) { ++examined; }
+  } counter;
+  REQUIRE_FALSE(xgraph::algorithm::DFS(u_graph, u_graph.GetNode(0), counter));
+  REQUIRE(counter.examined == 2);
+}
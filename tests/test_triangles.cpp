@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+TEST_CASE("Triangle Counting", "CSRGraph") {
+  using Node = XNode<>;
+  using Edge = XEdge<Node>;
+
+  SECTION("Complete graph") {
+    xgraph::Graph<Node, Edge> graph;
+    for (std::size_t i = 0; i < 5; ++i) {
+      graph.AddNode(i);
+    }
+    for (std::size_t i = 0; i < 5; ++i) {
+      for (std::size_t j = i + 1; j < 5; ++j) {
+        graph.AddEdge(i, j);
+      }
+    }
+    REQUIRE(xgraph::algorithm::CountTriangles(graph) == 10);
+    REQUIRE(xgraph::algorithm::NodeTriangles(graph) ==
+            std::vector<std::size_t>(5, 6));
+  }
+
+  SECTION("Directions, loops and reciprocal edges are ignored") {
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < 4; ++i) {
+      graph.AddNode(i);
+    }
+    graph.AddEdge(0, 1);
+    graph.AddEdge(1, 0);
+    graph.AddEdge(2, 1);
+    graph.AddEdge(0, 2);
+    graph.AddEdge(2, 2);
+    graph.AddEdge(2, 3);
+    REQUIRE(xgraph::algorithm::CountTriangles(graph) == 1);
+    REQUIRE(xgraph::algorithm::NodeTriangles(graph) ==
+            std::vector<std::size_t>{1, 1, 1, 0});
+
+    std::vector<std::size_t> ids;
+    xgraph::algorithm::ListTriangles(
+        graph, [&ids](const auto& a, const auto& b, const auto& c) {
+          ids.insert(ids.end(), {a->Id(), b->Id(), c->Id()});
+        });
+    std::ranges::sort(ids);
+    REQUIRE(ids == std::vector<std::size_t>{0, 1, 2});
+  }
+
+  SECTION("Random graph against brute force") {
+    constexpr std::size_t size = 60;
+    xgraph::DiGraph<Node, Edge> graph;
+    for (std::size_t i = 0; i < size; ++i) {
+      graph.AddNode(i);
+    }
+    std::vector<std::vector<bool>> adjacent(size,
+                                            std::vector<bool>(size, false));
+    std::mt19937 rng(5);
+    for (std::size_t k = 0; k < 6 * size; ++k) {
+      const auto s = rng() % size;
+      const auto t = rng() % size;
+      if (s != t && !graph.GetEdge(s, t, std::nullopt)) {
+        graph.AddEdge(s, t);
+        adjacent[s][t] = adjacent[t][s] = true;
+      }
+    }
+
+    std::size_t expected{0};
+    std::vector<std::size_t> per_node(size, 0);
+    std::set<std::tuple<std::size_t, std::size_t, std::size_t>> triangles;
+    for (std::size_t a = 0; a < size; ++a) {
+      for (std::size_t b = a + 1; b < size; ++b) {
+        for (std::size_t c = b + 1; c < size; ++c) {
+          if (adjacent[a][b] && adjacent[b][c] && adjacent[a][c]) {
+            ++expected;
+            ++per_node[a];
+            ++per_node[b];
+            ++per_node[c];
+            triangles.emplace(a, b, c);
+          }
+        }
+      }
+    }
+    REQUIRE(expected > 0);
+
+    const xgraph::CSRGraph<Node, Edge> csr(graph);
+    for (const auto threads : {std::size_t{1}, std::size_t{4}}) {
+      REQUIRE(xgraph::algorithm::CountTriangles(csr, threads) == expected);
+      REQUIRE(xgraph::algorithm::NodeTriangles(csr, threads) == per_node);
+    }
+
+    std::set<std::tuple<std::size_t, std::size_t, std::size_t>> listed;
+    std::size_t calls{0};
+    xgraph::algorithm::ListTriangles(
+        csr, [&](const auto& a, const auto& b, const auto& c) {
+          std::vector<std::size_t> ids{a->Id(), b->Id(), c->Id()};
+          std::ranges::sort(ids);
+          listed.emplace(ids[0], ids[1], ids[2]);
+          ++calls;
+        });
+    REQUIRE(calls == expected);
+    REQUIRE(listed == triangles);
+  }
+}
@@ -0,0 +1,133 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#include "xgraph"
+
+using xgraph::XEdge;
+using xgraph::XNode;
+
+// Counting allocator: every heap allocation of the test binary goes through
+// these replacements
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(const std::size_t size) {
+  ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+// Not inlined, so callers do not see `free` paired with `new`
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }
+
+TEST_CASE("Workspace Zero Allocation", "CSRGraph") {
+  using Node = XNode<>;
+  using Edge = XEdge<Node, xgraph::EmptyObject, double>;
+  constexpr std::size_t size = 200;
+
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < size; ++i) {
+    graph.AddNode(i);
+  }
+  for (std::size_t i = 0; i + 1 < size; ++i) {
+    graph.AddEdge(i, i + 1, 1.0 + static_cast<double>(i % 3));
+    if (i + 5 < size) {
+      graph.AddEdge(i, i + 5, 4.0);
+    }
+  }
+  const xgraph::CSRGraph<Node, Edge> csr(graph);
+
+  std::size_t visited{0};
+  const std::optional<xgraph::NodePtrVisitor_t<Node>> count =
+      [&visited](const std::shared_ptr<Node>&) { ++visited; };
+  const auto source = graph.GetNode(0);
+  const auto target = graph.GetNode(size - 1);
+
+  xgraph::algorithm::Workspace ws(csr.NodeSize());
+  xgraph::algorithm::PathResult<Node> res;
+  const auto run = [&] {
+    xgraph::algorithm::BFS(csr, source, ws, count);
+    xgraph::algorithm::DFS(csr, target, ws, count);
+    xgraph::algorithm::TopologicalSort(csr, ws, count);
+    xgraph::algorithm::AStarPath(csr, source, target, ws, res);
+  };
+
+  // Warm-up grows the DFS stack and the path buffer
+  run();
+  REQUIRE(visited == 3 * size);
+  REQUIRE(res.reachable);
+  const auto expected = res.cost;
+
+  const auto before = allocations.load();
+  for (int i = 0; i < 10; ++i) {
+    run();
+  }
+  const auto after = allocations.load();
+  REQUIRE(before > 0);
+  REQUIRE(after == before);
+  REQUIRE(visited == 33 * size);
+  REQUIRE(res.cost == expected);
+  REQUIRE(res.path.front() == source);
+  REQUIRE(res.path.back() == target);
+}
+
+TEST_CASE("Workspace Traversal Order", "CSRGraph") {
+  using Node = XNode<>;
+  using Edge = XEdge<Node>;
+
+  xgraph::DiGraph<Node, Edge> graph;
+  for (std::size_t i = 0; i < 6; ++i) {
+    graph.AddNode(i);
+  }
+  graph.AddEdge(0, 1);
+  graph.AddEdge(0, 2);
+  graph.AddEdge(1, 3);
+  graph.AddEdge(2, 3);
+  graph.AddEdge(3, 4);
+  graph.AddEdge(5, 4);
+  const xgraph::CSRGraph<Node, Edge> csr(graph);
+  xgraph::algorithm::Workspace ws;
+
+  std::vector<std::size_t> order;
+  const std::optional<xgraph::NodePtrVisitor_t<Node>> record =
+      [&order](const std::shared_ptr<Node>& n) { order.push_back(n->Id()); };
+
+  // Same nodes as the traversals of the graph
+  for (const auto start : {std::size_t{0}, std::size_t{4}}) {
+    order.clear();
+    xgraph::algorithm::BFS(graph, graph.GetNode(start), record);
+    auto expected = order;
+    std::ranges::sort(expected);
+
+    order.clear();
+    xgraph::algorithm::BFS(csr, graph.GetNode(start), ws, record);
+    REQUIRE(order.front() == start);
+    std::ranges::sort(order);
+    REQUIRE(order == expected);
+
+    order.clear();
+    xgraph::algorithm::DFS(csr, graph.GetNode(start), ws, record);
+    REQUIRE(order.front() == start);
+    std::ranges::sort(order);
+    REQUIRE(order == expected);
+  }
+
+  order.clear();
+  xgraph::algorithm::TopologicalSort(csr, ws, record);
+  REQUIRE(order == std::vector<std::size_t>{0, 5, 1, 2, 3, 4});
+
+  order.clear();
+  xgraph::algorithm::BFS(csr, std::make_shared<Node>("missing"), ws, record);
+  REQUIRE(order.empty());
+
+  graph.AddEdge(4, 0);
+  REQUIRE_THROWS_AS(xgraph::algorithm::TopologicalSort(
+                        xgraph::CSRGraph<Node, Edge>(graph), ws),
+                    std::runtime_error);
+}
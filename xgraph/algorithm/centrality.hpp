@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/parallel.hpp"
+#include "structure/type_traits.hpp"
+
+namespace xgraph::algorithm {
+
+namespace detail {
+
+//! @brief Per-worker state of Brandes' algorithm
+struct BrandesState {
+  /*!
+   * @brief Constructor
+   * @param size Size of nodes
+   */
+  explicit BrandesState(const std::size_t size)
+      : dist(size, std::numeric_limits<double>::infinity()), sigma(size, 0.0),
+        delta(size, 0.0), centrality(size, 0.0) {}
+
+  //! @brief Distance from the source
+  std::vector<double> dist;
+
+  //! @brief Number of shortest paths from the source
+  std::vector<double> sigma;
+
+  //! @brief Dependency of the source on every node
+  std::vector<double> delta;
+
+  //! @brief Betweenness accumulated by the worker
+  std::vector<double> centrality;
+
+  //! @brief Reached nodes by non-decreasing distance
+  std::vector<std::size_t> order;
+
+  //! @brief Binary heap of (distance, dense index), weighted graphs only
+  std::vector<std::pair<double, std::size_t>> heap;
+};
+
+/*!
+ * @brief Shortest paths from one source and dependency accumulation
+ *
+ * Dependencies are pulled from successors in reverse distance order, so only
+ * out arcs are needed and no predecessor lists are kept.
+ *
+ * @param csr Graph snapshot
+ * @param source Dense index of source
+ * @param state Worker state, reset to its initial values on return except
+ * for `centrality`
+ */
+template <NodeType Node, EdgeType Edge>
+void BrandesSource(const CSRGraph<Node, Edge>& csr, const std::size_t source,
+                   BrandesState& state) {
+  const auto weight = [&csr](const std::size_t v, const std::size_t k) {
+    if constexpr (IsUnweighted_v<Edge>) {
+      return 1.0;
+    } else {
+      return static_cast<double>(csr.OutWeights(v)[k]);
+    }
+  };
+
+  state.dist[source] = 0.0;
+  state.sigma[source] = 1.0;
+  if constexpr (IsUnweighted_v<Edge>) {
+    // `order` doubles as the queue
+    state.order.push_back(source);
+    for (std::size_t head = 0; head < state.order.size(); ++head) {
+      const auto v = state.order[head];
+      for (const auto w : csr.OutNeighbors(v)) {
+        if (state.dist[w] == std::numeric_limits<double>::infinity()) {
+          state.dist[w] = state.dist[v] + 1.0;
+          state.order.push_back(w);
+        }
+        if (state.dist[w] == state.dist[v] + 1.0) {
+          state.sigma[w] += state.sigma[v];
+        }
+      }
+    }
+  } else {
+    state.heap.emplace_back(0.0, source);
+    while (!state.heap.empty()) {
+      std::ranges::pop_heap(state.heap, std::greater{});
+      const auto [d, v] = state.heap.back();
+      state.heap.pop_back();
+      if (d > state.dist[v]) {
+        continue;
+      }
+      state.order.push_back(v);
+      const auto row = csr.OutNeighbors(v);
+      for (std::size_t k = 0; k < row.size(); ++k) {
+        const auto w = row[k];
+        const auto nd = d + weight(v, k);
+        if (nd < state.dist[w]) {
+          state.dist[w] = nd;
+          state.sigma[w] = state.sigma[v];
+          state.heap.emplace_back(nd, w);
+          std::ranges::push_heap(state.heap, std::greater{});
+        } else if (nd == state.dist[w]) {
+          state.sigma[w] += state.sigma[v];
+        }
+      }
+    }
+  }
+
+  for (const auto v : state.order | std::views::reverse) {
+    const auto row = csr.OutNeighbors(v);
+    for (std::size_t k = 0; k < row.size(); ++k) {
+      const auto w = row[k];
+      if (state.dist[v] + weight(v, k) == state.dist[w]) {
+        state.delta[v] +=
+            state.sigma[v] / state.sigma[w] * (1.0 + state.delta[w]);
+      }
+    }
+    if (v != source) {
+      state.centrality[v] += state.delta[v];
+    }
+  }
+
+  for (const auto v : state.order) {
+    state.dist[v] = std::numeric_limits<double>::infinity();
+    state.sigma[v] = 0.0;
+    state.delta[v] = 0.0;
+  }
+  state.order.clear();
+}
+
+} // namespace detail
+
+/*!
+ * @brief Betweenness centrality by Brandes' algorithm
+ *
+ * Sources are spread over worker threads, each accumulating dependencies in
+ * its own array, and the arrays are summed at the end. With `samples`, only
+ * that many distinct sources drawn at random are used and the result is
+ * scaled by `NodeSize() / samples`, an unbiased estimate of the exact
+ * values.
+ *
+ * Values are not normalized. Pairs of an undirected graph are counted once.
+ *
+ * @param csr Graph snapshot
+ * @param samples Size of sampled sources (0 or at least `NodeSize()` for the
+ * exact values)
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @param seed Seed of the source sampling
+ * @return Betweenness of every dense index
+ * @throw std::invalid_argument if a weight is not positive
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<double> Betweenness(const CSRGraph<Node, Edge>& csr,
+                                const std::size_t samples = 0,
+                                const std::size_t threads = 0,
+                                const std::uint64_t seed = 0) {
+  const auto n = csr.NodeSize();
+  if constexpr (!IsUnweighted_v<Edge>) {
+    for (std::size_t v = 0; v < n; ++v) {
+      for (const auto w : csr.OutWeights(v)) {
+        if (!(w > 0)) {
+          throw std::invalid_argument("Betweenness needs positive weights");
+        }
+      }
+    }
+  }
+
+  std::vector<std::size_t> sources(n);
+  std::iota(sources.begin(), sources.end(), 0);
+  auto scale = csr.IsDirected() ? 1.0 : 0.5;
+  if (samples != 0 && samples < n) {
+    // Partial Fisher-Yates shuffle
+    std::mt19937_64 rng(seed);
+    for (std::size_t i = 0; i < samples; ++i) {
+      std::uniform_int_distribution<std::size_t> pick(i, n - 1);
+      std::swap(sources[i], sources[pick(rng)]);
+    }
+    sources.resize(samples);
+    scale *= static_cast<double>(n) / static_cast<double>(samples);
+  }
+
+  std::vector<detail::BrandesState> states(
+      std::min(utils::WorkerCount(threads), std::max<std::size_t>(n, 1)),
+      detail::BrandesState(n));
+  utils::ParallelFor(sources.size(), threads,
+                     [&](const std::size_t worker, const std::size_t i) {
+                       detail::BrandesSource(csr, sources[i], states[worker]);
+                     });
+
+  std::vector<double> res(n, 0.0);
+  for (const auto& state : states) {
+    for (std::size_t v = 0; v < n; ++v) {
+      res[v] += state.centrality[v];
+    }
+  }
+  for (auto& value : res) {
+    value *= scale;
+  }
+  return res;
+}
+
+/*!
+ * @brief Betweenness centrality of a graph by Brandes' algorithm
+ * @param graph Graph
+ * @param samples Size of sampled sources (0 for the exact values)
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @param seed Seed of the source sampling
+ * @return Betweenness of every dense index of `CSRGraph(graph)` (node id
+ * order)
+ * @throw std::invalid_argument if a weight is not positive
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<double> Betweenness(const DiGraph<Node, Edge>& graph,
+                                const std::size_t samples = 0,
+                                const std::size_t threads = 0,
+                                const std::uint64_t seed = 0) {
+  return Betweenness(CSRGraph<Node, Edge>(graph), samples, threads, seed);
+}
+
+} // namespace xgraph::algorithm
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/parallel.hpp"
+#include "structure/type_traits.hpp"
+
+namespace xgraph::algorithm {
+
+/*!
+ * @brief Strongly connected components by iterative Pearce (Tarjan variant)
+ *
+ * The depth-first search keeps an explicit stack, so deep graphs do not
+ * overflow the call stack. Besides the stacks it uses one index per node and
+ * one bit per node.
+ *
+ * @param csr Graph snapshot
+ * @return Component of every dense index in `[0, components)`, numbered in
+ * reverse topological order (sinks first)
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t>
+StronglyConnectedComponents(const CSRGraph<Node, Edge>& csr) {
+  const auto n = csr.NodeSize();
+
+  // 0 for unvisited nodes, then visit index while on the stack, then
+  // component id counted down from `n - 1` once assigned
+  std::vector<std::size_t> rindex(n, 0);
+  std::vector<bool> root(n, false);
+  std::vector<std::size_t> scc_stack;
+  // (node, position in its out row)
+  std::vector<std::pair<std::size_t, std::size_t>> call_stack;
+  std::size_t index{1};
+  auto component = n;
+
+  const auto begin = [&](const std::size_t v) {
+    root[v] = true;
+    rindex[v] = index++;
+    call_stack.emplace_back(v, 0);
+  };
+
+  for (std::size_t r = 0; r < n; ++r) {
+    if (rindex[r] != 0) {
+      continue;
+    }
+    begin(r);
+
+    while (!call_stack.empty()) {
+      const auto [v, pos] = call_stack.back();
+      const auto neighbors = csr.OutNeighbors(v);
+
+      if (pos < neighbors.size()) {
+        const auto w = neighbors[pos];
+        if (rindex[w] == 0) {
+          // The arc is looked at again once `w` is finished
+          begin(w);
+          continue;
+        }
+        if (rindex[w] < rindex[v]) {
+          rindex[v] = rindex[w];
+          root[v] = false;
+        }
+        ++call_stack.back().second;
+        continue;
+      }
+
+      // All children explored
+      call_stack.pop_back();
+      if (!root[v]) {
+        scc_stack.push_back(v);
+        continue;
+      }
+      --index;
+      --component;
+      while (!scc_stack.empty() && rindex[v] <= rindex[scc_stack.back()]) {
+        rindex[scc_stack.back()] = component;
+        scc_stack.pop_back();
+        --index;
+      }
+      rindex[v] = component;
+    }
+  }
+
+  // Renumber from `n - 1` downwards to `0` upwards
+  for (auto& c : rindex) {
+    c = n - 1 - c;
+  }
+  return rindex;
+}
+
+/*!
+ * @brief Strongly connected components by iterative Pearce
+ * @param graph Graph
+ * @return Component of every dense index of `CSRGraph(graph)` (node id
+ * order), numbered in reverse topological order
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t>
+StronglyConnectedComponents(const DiGraph<Node, Edge>& graph) {
+  return StronglyConnectedComponents(CSRGraph<Node, Edge>(graph));
+}
+
+namespace detail {
+
+//! @brief Size of nodes below which a round runs on the calling thread
+inline constexpr std::size_t SCC_CUTOFF = 1024;
+
+} // namespace detail
+
+/*!
+ * @brief Strongly connected components by parallel forward-backward search
+ *
+ * Nodes without live in or out arcs are trimmed first, round by round in
+ * parallel, as singleton components. The rest is split recursively: the
+ * nodes both reachable from and reaching a pivot form its component, and
+ * the forward only, backward only and untouched nodes form three
+ * independent subproblems. Subproblems of a round run in parallel, each
+ * search being sequential. Workers are started once for all rounds, and
+ * rounds over fewer than `detail::SCC_CUTOFF` nodes run on the calling
+ * thread.
+ *
+ * @param csr Graph snapshot
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Component of every dense index in `[0, components)`, partition
+ * equal to `StronglyConnectedComponents` but numbered in no particular order
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t>
+ParallelStronglyConnectedComponents(const CSRGraph<Node, Edge>& csr,
+                                    const std::size_t threads = 0) {
+  constexpr auto npos = CSRGraph<Node, Edge>::npos;
+  const auto n = csr.NodeSize();
+  std::vector<std::size_t> component(n, npos);
+  std::atomic<std::size_t> component_num{0};
+
+  // Trimming
+  std::vector<std::size_t> in(n);
+  std::vector<std::size_t> out(n);
+  std::vector<std::uint8_t> trimmed(n, 0);
+  std::vector<std::size_t> frontier;
+  for (std::size_t v = 0; v < n; ++v) {
+    in[v] = csr.InDegree(v);
+    out[v] = csr.OutDegree(v);
+    if (in[v] == 0 || out[v] == 0) {
+      frontier.push_back(v);
+    }
+  }
+  utils::WorkerPool pool(
+      std::min(utils::WorkerCount(threads), std::max<std::size_t>(n, 1)));
+  // Run `func(worker, i)` for `i` in `[0, size)`, inline if a round covers
+  // few nodes
+  const auto round = [&pool](const std::size_t size, const std::size_t nodes,
+                             const auto& func) {
+    if (nodes < detail::SCC_CUTOFF) {
+      for (std::size_t i = 0; i < size; ++i) {
+        func(0, i);
+      }
+    } else {
+      pool.ParallelFor(size, func);
+    }
+  };
+
+  std::vector<std::vector<std::size_t>> next(pool.Size());
+  while (!frontier.empty()) {
+    round(
+        frontier.size(), frontier.size(),
+        [&](const std::size_t worker, const std::size_t i) {
+          const auto v = frontier[i];
+          // Nodes can reach the frontier through both in and out arcs
+          if (std::atomic_ref<std::uint8_t>(trimmed[v]).exchange(1) != 0) {
+            return;
+          }
+          component[v] = component_num++;
+          for (const auto u : csr.OutNeighbors(v)) {
+            if (std::atomic_ref<std::size_t>(in[u]).fetch_sub(1) == 1) {
+              next[worker].push_back(u);
+            }
+          }
+          for (const auto u : csr.InNeighbors(v)) {
+            if (std::atomic_ref<std::size_t>(out[u]).fetch_sub(1) == 1) {
+              next[worker].push_back(u);
+            }
+          }
+        });
+    frontier.clear();
+    for (auto& part : next) {
+      frontier.insert(frontier.end(), part.begin(), part.end());
+      part.clear();
+    }
+  }
+
+  // Forward-backward. Every subproblem owns its nodes, searches only read
+  // `color` and `component`, which are written once the round is over.
+  std::size_t next_component = component_num;
+  std::vector<std::size_t> color(n, 0);
+  std::vector<std::uint8_t> mark(n, 0);
+  std::vector<std::vector<std::size_t>> tasks(1);
+  for (std::size_t v = 0; v < n; ++v) {
+    if (component[v] == npos) {
+      tasks.front().push_back(v);
+    }
+  }
+  // Size of nodes in all subproblems of the round
+  auto nodes_num = tasks.front().size();
+  if (tasks.front().empty()) {
+    tasks.clear();
+  }
+  std::size_t color_num{1};
+  // Parts of every subproblem by mark: untouched, forward only, backward
+  // only and component of the pivot
+  std::vector<std::array<std::vector<std::size_t>, 4>> parts;
+  std::vector<std::array<std::size_t, 4>> labels;
+  while (!tasks.empty()) {
+    parts.assign(tasks.size(), {});
+    round(
+        tasks.size(), nodes_num, [&](std::size_t, const std::size_t i) {
+          const auto& nodes = tasks[i];
+          const auto own = color[nodes.front()];
+
+          // Reach of the pivot inside the subproblem
+          std::vector<std::size_t> stack;
+          const auto search = [&](const std::uint8_t bit, const auto& rows) {
+            stack.push_back(nodes.front());
+            mark[nodes.front()] |= bit;
+            while (!stack.empty()) {
+              const auto v = stack.back();
+              stack.pop_back();
+              for (const auto u : rows(v)) {
+                if (component[u] == npos && color[u] == own &&
+                    (mark[u] & bit) == 0) {
+                  mark[u] |= bit;
+                  stack.push_back(u);
+                }
+              }
+            }
+          };
+          search(1, [&csr](std::size_t v) { return csr.OutNeighbors(v); });
+          search(2, [&csr](std::size_t v) { return csr.InNeighbors(v); });
+
+          for (const auto v : nodes) {
+            parts[i][mark[v]].push_back(v);
+            mark[v] = 0;
+          }
+        });
+
+    // Fresh component of every pivot and color of every new subproblem
+    labels.assign(tasks.size(), {});
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+      labels[i][3] = next_component++;
+      for (std::size_t k = 0; k < 3; ++k) {
+        labels[i][k] = parts[i][k].empty() ? 0 : color_num++;
+      }
+    }
+    round(tasks.size(), nodes_num, [&](std::size_t, const std::size_t i) {
+      for (const auto v : parts[i][3]) {
+        component[v] = labels[i][3];
+      }
+      for (std::size_t k = 0; k < 3; ++k) {
+        for (const auto v : parts[i][k]) {
+          color[v] = labels[i][k];
+        }
+      }
+    });
+
+    tasks.clear();
+    nodes_num = 0;
+    for (auto& task : parts) {
+      for (std::size_t k = 0; k < 3; ++k) {
+        if (!task[k].empty()) {
+          nodes_num += task[k].size();
+          tasks.push_back(std::move(task[k]));
+        }
+      }
+    }
+  }
+  return component;
+}
+
+/*!
+ * @brief Strongly connected components by parallel forward-backward search
+ * @param graph Graph
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Component of every dense index of `CSRGraph(graph)` (node id
+ * order)
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t>
+ParallelStronglyConnectedComponents(const DiGraph<Node, Edge>& graph,
+                                    const std::size_t threads = 0) {
+  return ParallelStronglyConnectedComponents(CSRGraph<Node, Edge>(graph),
+                                             threads);
+}
+
+/*!
+ * @brief Condensation DAG of a snapshot
+ * @param csr Graph snapshot
+ * @param component Components returned by `StronglyConnectedComponents` or
+ * `ParallelStronglyConnectedComponents`
+ * @return Graph with one node per component, whose id is the component, and
+ * one edge between two components joined by at least one arc
+ */
+template <NodeType Node, EdgeType Edge>
+DiGraph<XNode<>, XEdge<>>
+Condensation(const CSRGraph<Node, Edge>& csr,
+             const std::vector<std::size_t>& component) {
+  std::size_t component_num{0};
+  for (const auto c : component) {
+    component_num = std::max(component_num, c + 1);
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> arcs;
+  for (std::size_t v = 0; v < csr.NodeSize(); ++v) {
+    for (const auto u : csr.OutNeighbors(v)) {
+      if (component[v] != component[u]) {
+        arcs.emplace_back(component[v], component[u]);
+      }
+    }
+  }
+  std::ranges::sort(arcs);
+  const auto [first, last] = std::ranges::unique(arcs);
+  arcs.erase(first, last);
+
+  DiGraph<XNode<>, XEdge<>> res;
+  for (std::size_t c = 0; c < component_num; ++c) {
+    res.AddNode(c);
+  }
+  for (const auto& [s, t] : arcs) {
+    res.AddEdge(s, t);
+  }
+  return res;
+}
+
+} // namespace xgraph::algorithm
@@ -0,0 +1,702 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "algorithm/shortest_path.hpp"
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/type_traits.hpp"
+#include "structure/visited_set.hpp"
+
+namespace xgraph::algorithm {
+
+/*!
+ * @brief Contraction Hierarchies for repeated point to point shortest paths
+ *
+ * Preprocessing contracts nodes one by one in the order of their edge
+ * difference (shortcuts added minus arcs removed, weighted twice, plus
+ * contracted neighbors to spread the contraction). When a node is
+ * contracted, a shortcut replaces every path through it between its
+ * remaining neighbors unless a bounded witness search finds a path that is
+ * not longer. The arcs of a contracted node form the upward graph (towards
+ * higher ranks) and the downward graph, and queries run a bidirectional
+ * Dijkstra with stall on demand that only goes upward on both sides.
+ * Shortcuts remember the contracted node they skip, so paths are unpacked
+ * to the original nodes.
+ *
+ * Weights are read as `double` and must not be negative. The hierarchy does
+ * not observe later changes of the graph.
+ *
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node, EdgeType Edge> class ContractionHierarchy {
+  using NodePtr = std::shared_ptr<Node>;
+
+  static constexpr std::size_t none = CSRGraph<Node, Edge>::npos;
+
+  //! @brief Arc of the hierarchy
+  struct Arc {
+    //! @brief Dense index of the other end
+    std::size_t target;
+
+    //! @brief Weight
+    double weight;
+
+    //! @brief Skipped node of a shortcut (`none` for original arcs)
+    std::size_t middle;
+  };
+
+  //! @brief Tag and layout version of the serialized form
+  static constexpr std::uint32_t MAGIC = 0x48434758; // "XGCH"
+  static constexpr std::uint32_t FORMAT = 1;
+
+public:
+  /*!
+   * @brief Default constructor (empty hierarchy)
+   */
+  ContractionHierarchy() = default;
+
+  /*!
+   * @brief Preprocess a snapshot
+   * @param csr Graph snapshot
+   * @param witness_limit Maximal nodes settled by one witness search, more
+   * shortcuts are kept when it is reached
+   * @throw std::invalid_argument if a weight is negative
+   */
+  explicit ContractionHierarchy(const CSRGraph<Node, Edge>& csr,
+                                const std::size_t witness_limit = 500) {
+    Build(csr, witness_limit);
+  }
+
+  /*!
+   * @brief Preprocess a graph
+   * @param graph Graph
+   * @param witness_limit Maximal nodes settled by one witness search
+   * @throw std::invalid_argument if a weight is negative
+   */
+  explicit ContractionHierarchy(const DiGraph<Node, Edge>& graph,
+                                const std::size_t witness_limit = 500) {
+    Build(CSRGraph<Node, Edge>(graph), witness_limit);
+  }
+
+  /*!
+   * @brief Get size of nodes
+   * @return Size of nodes
+   */
+  [[nodiscard]] std::size_t NodeSize() const { return _nodes.size(); }
+
+  /*!
+   * @brief Get size of shortcuts in the hierarchy
+   * @return Size of shortcuts
+   */
+  [[nodiscard]] std::size_t ShortcutSize() const { return _shortcut_size; }
+
+  /*!
+   * @brief Get contraction rank of a node
+   * @param n Node ptr
+   * @return Rank (contracted first is 0) if exists else `npos`
+   */
+  [[nodiscard]] std::size_t Rank(const NodePtr& n) const {
+    const auto i = Index(n);
+    return i == none ? none : _rank[i];
+  }
+
+  /*!
+   * @brief Shortest path between two nodes
+   * @param source Source node
+   * @param target Target node
+   * @return Path of original nodes and its cost, unreachable targets and
+   * nodes that are not in the hierarchy are flagged
+   */
+  PathResult<Node> Query(const NodePtr& source, const NodePtr& target) const {
+    PathResult<Node> res;
+    const auto s = Index(source);
+    const auto t = Index(target);
+    if (s == none || t == none) {
+      return res;
+    }
+
+    // Search spaces are small, so both sides use hash maps
+    Search forward{s};
+    Search backward{t};
+    auto best = std::numeric_limits<double>::infinity();
+    auto meet = none;
+
+    while (true) {
+      // Each side stops once it can no longer improve the best path
+      const auto active = [best](const Search& search) {
+        return !search.heap.empty() && search.heap.front().first < best;
+      };
+      const auto f = active(forward);
+      const auto b = active(backward);
+      if (!f && !b) {
+        break;
+      }
+      const bool go_forward =
+          f && (!b || forward.heap.front().first <=
+                          backward.heap.front().first);
+      auto& search = go_forward ? forward : backward;
+      const auto& other = go_forward ? backward : forward;
+
+      const auto [dist, v] = search.Pop();
+      if (dist > search.label.at(v).first) {
+        continue;
+      }
+      if (const auto it = other.label.find(v);
+          it != other.label.end() && dist + it->second.first < best) {
+        best = dist + it->second.first;
+        meet = v;
+      }
+
+      const auto& offsets = go_forward ? _up_offsets : _down_offsets;
+      const auto& arcs = go_forward ? _up_arcs : _down_arcs;
+
+      // Stall on demand: a higher node reached by this side may already give
+      // a shorter path to `v`, then nothing found from `v` is shortest
+      const auto& reverse_offsets = go_forward ? _down_offsets : _up_offsets;
+      const auto& reverse_arcs = go_forward ? _down_arcs : _up_arcs;
+      bool stalled{false};
+      for (auto k = reverse_offsets[v]; k < reverse_offsets[v + 1]; ++k) {
+        const auto it = search.label.find(reverse_arcs[k].target);
+        if (it != search.label.end() &&
+            it->second.first + reverse_arcs[k].weight < dist) {
+          stalled = true;
+          break;
+        }
+      }
+      if (stalled) {
+        continue;
+      }
+      for (auto k = offsets[v]; k < offsets[v + 1]; ++k) {
+        search.Relax(arcs[k].target, dist + arcs[k].weight, v);
+      }
+    }
+
+    if (meet == none) {
+      return res;
+    }
+
+    // Upward arcs from the source, then the arcs down to the target
+    std::vector<std::size_t> up_nodes;
+    for (auto v = meet; v != none; v = forward.label.at(v).second) {
+      up_nodes.push_back(v);
+    }
+    std::ranges::reverse(up_nodes);
+    std::vector<std::size_t> path{s};
+    for (std::size_t k = 1; k < up_nodes.size(); ++k) {
+      Unpack(up_nodes[k - 1], up_nodes[k], path);
+    }
+    for (auto v = meet; v != t;) {
+      const auto next = backward.label.at(v).second;
+      Unpack(v, next, path);
+      v = next;
+    }
+
+    res.reachable = true;
+    res.cost = best;
+    res.path.reserve(path.size());
+    for (const auto v : path) {
+      res.path.push_back(_nodes[v]);
+    }
+    return res;
+  }
+
+  /*!
+   * @brief Write the hierarchy in binary form (native byte order)
+   * @param out Output stream
+   */
+  void Save(std::ostream& out) const {
+    Write(out, MAGIC);
+    Write(out, FORMAT);
+    Write(out, static_cast<std::uint64_t>(_nodes.size()));
+    Write(out, static_cast<std::uint64_t>(_shortcut_size));
+    for (const auto& n : _nodes) {
+      Write(out, static_cast<std::uint64_t>(n->Id()));
+    }
+    WriteVector(out, _rank);
+    WriteVector(out, _up_offsets);
+    WriteVector(out, _up_arcs);
+    WriteVector(out, _down_offsets);
+    WriteVector(out, _down_arcs);
+  }
+
+  /*!
+   * @brief Read a hierarchy written by `Save`
+   * @param in Input stream
+   * @param graph Graph the hierarchy was built from, provides the nodes
+   * @return Hierarchy
+   * @throw std::runtime_error if the data is truncated or malformed, or a
+   * node is missing
+   */
+  static ContractionHierarchy Load(std::istream& in,
+                                   const DiGraph<Node, Edge>& graph) {
+    if (Read<std::uint32_t>(in) != MAGIC ||
+        Read<std::uint32_t>(in) != FORMAT) {
+      throw std::runtime_error("Not a contraction hierarchy");
+    }
+
+    ContractionHierarchy res;
+    const auto n = static_cast<std::size_t>(Read<std::uint64_t>(in));
+    res._shortcut_size = static_cast<std::size_t>(Read<std::uint64_t>(in));
+    if (n > Remaining(in) / sizeof(std::uint64_t)) {
+      throw std::runtime_error("Truncated contraction hierarchy");
+    }
+    res._nodes.reserve(n);
+    res._index.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto id = static_cast<std::size_t>(Read<std::uint64_t>(in));
+      auto node = graph.GetNode(id);
+      if (!node) {
+        throw std::runtime_error("Contraction hierarchy node not in graph");
+      }
+      res._index.emplace(id, i);
+      res._nodes.push_back(std::move(node));
+    }
+    ReadVector(in, res._rank, n);
+    ReadVector(in, res._up_offsets, n + 1);
+    ReadVector(in, res._up_arcs, res._up_offsets.back());
+    ReadVector(in, res._down_offsets, n + 1);
+    ReadVector(in, res._down_arcs, res._down_offsets.back());
+    res.Validate();
+    return res;
+  }
+
+private:
+  //! @brief One side of a query
+  struct Search {
+    explicit Search(const std::size_t start) {
+      label.emplace(start, std::pair{0.0, none});
+      heap.emplace_back(0.0, start);
+    }
+
+    std::pair<double, std::size_t> Pop() {
+      std::ranges::pop_heap(heap, std::greater{});
+      const auto res = heap.back();
+      heap.pop_back();
+      return res;
+    }
+
+    void Relax(const std::size_t v, const double dist,
+               const std::size_t parent) {
+      if (const auto [it, inserted] = label.try_emplace(v, dist, parent);
+          !inserted) {
+        if (it->second.first <= dist) {
+          return;
+        }
+        it->second = {dist, parent};
+      }
+      heap.emplace_back(dist, v);
+      std::ranges::push_heap(heap, std::greater{});
+    }
+
+    //! @brief Distance and parent of reached nodes
+    std::unordered_map<std::size_t, std::pair<double, std::size_t>> label;
+
+    //! @brief Binary heap of (distance, dense index)
+    std::vector<std::pair<double, std::size_t>> heap;
+  };
+
+  /*!
+   * @brief Contract every node and split arcs into upward / downward graphs
+   * @param csr Graph snapshot
+   * @param witness_limit Maximal nodes settled by one witness search
+   */
+  void Build(const CSRGraph<Node, Edge>& csr,
+             const std::size_t witness_limit) {
+    const auto n = csr.NodeSize();
+    _nodes.reserve(n);
+    _index.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      _nodes.push_back(csr.GetNode(i));
+      _index.emplace(_nodes.back()->Id(), i);
+    }
+
+    // Remaining graph, only the lightest arc between two nodes is kept.
+    // `in[v]` holds arcs into `v` with `target` set to their source.
+    std::vector<std::vector<Arc>> out(n);
+    std::vector<std::vector<Arc>> in(n);
+    const auto add_arc = [&out, &in](const std::size_t u, const std::size_t v,
+                                     const double w, const std::size_t mid) {
+      const auto it = std::ranges::find(out[u], v, &Arc::target);
+      if (it == out[u].end()) {
+        out[u].push_back({v, w, mid});
+        in[v].push_back({u, w, mid});
+      } else if (w < it->weight) {
+        *it = {v, w, mid};
+        *std::ranges::find(in[v], u, &Arc::target) = {u, w, mid};
+      }
+    };
+    for (std::size_t s = 0; s < n; ++s) {
+      const auto row = csr.OutNeighbors(s);
+      for (std::size_t k = 0; k < row.size(); ++k) {
+        double w{1.0};
+        if constexpr (!IsUnweighted_v<Edge>) {
+          w = static_cast<double>(csr.OutWeights(s)[k]);
+        }
+        if (w < 0) {
+          throw std::invalid_argument("Negative edge weight");
+        }
+        if (row[k] != s) {
+          add_arc(s, row[k], w, none);
+        }
+      }
+    }
+
+    // Contracted neighbors of every remaining node
+    std::vector<std::size_t> deleted(n, 0);
+
+    // Witness search state, reused by every search. Searches stop once the
+    // `remaining` nodes of `targets` are settled.
+    utils::VisitedSet reached;
+    utils::VisitedSet targets;
+    std::vector<double> dist(n);
+    std::vector<std::pair<double, std::size_t>> heap;
+    const auto witness = [&](const std::size_t source,
+                             const std::size_t skipped, const double limit,
+                             std::size_t remaining) {
+      reached.Reset(n);
+      reached.Insert(source);
+      dist[source] = 0.0;
+      heap.assign(1, {0.0, source});
+      std::size_t settled{0};
+      while (!heap.empty() && settled < witness_limit) {
+        std::ranges::pop_heap(heap, std::greater{});
+        const auto [d, v] = heap.back();
+        heap.pop_back();
+        if (d > dist[v]) {
+          continue;
+        }
+        if (d > limit) {
+          break;
+        }
+        ++settled;
+        if (v != source && targets.Contains(v) && --remaining == 0) {
+          break;
+        }
+        for (const auto& a : out[v]) {
+          if (a.target == skipped) {
+            continue;
+          }
+          const auto nd = d + a.weight;
+          if (reached.Insert(a.target) || nd < dist[a.target]) {
+            dist[a.target] = nd;
+            heap.emplace_back(nd, a.target);
+            std::ranges::push_heap(heap, std::greater{});
+          }
+        }
+      }
+    };
+
+    // Shortcuts (source, target, weight) needed to contract `v`
+    std::vector<std::tuple<std::size_t, std::size_t, double>> shortcuts;
+    const auto find_shortcuts = [&](const std::size_t v) {
+      shortcuts.clear();
+      targets.Reset(n);
+      for (const auto& b : out[v]) {
+        targets.Insert(b.target);
+      }
+      for (const auto& a : in[v]) {
+        const auto u = a.target;
+        double longest{-1.0};
+        for (const auto& b : out[v]) {
+          if (b.target != u) {
+            longest = std::max(longest, b.weight);
+          }
+        }
+        if (longest < 0) {
+          continue;
+        }
+        witness(u, v, a.weight + longest,
+                out[v].size() - static_cast<std::size_t>(targets.Contains(u)));
+        for (const auto& b : out[v]) {
+          const auto x = b.target;
+          if (x == u) {
+            continue;
+          }
+          const auto via = a.weight + b.weight;
+          if (!reached.Contains(x) || dist[x] > via) {
+            shortcuts.emplace_back(u, x, via);
+          }
+        }
+      }
+    };
+    const auto priority = [&](const std::size_t v) {
+      find_shortcuts(v);
+      return 2.0 * (static_cast<double>(shortcuts.size()) -
+                    static_cast<double>(in[v].size() + out[v].size())) +
+             static_cast<double>(deleted[v]);
+    };
+
+    // Lazy updates: a popped node is contracted only if its fresh priority
+    // is still minimal
+    std::vector<std::pair<double, std::size_t>> queue;
+    queue.reserve(n);
+    for (std::size_t v = 0; v < n; ++v) {
+      queue.emplace_back(priority(v), v);
+    }
+    std::ranges::make_heap(queue, std::greater{});
+
+    // Arcs leaving the remaining graph are final: `up[v]` holds arcs from `v`
+    // and `down[v]` arcs into `v`, all to nodes contracted later
+    std::vector<std::vector<Arc>> up(n);
+    std::vector<std::vector<Arc>> down(n);
+    _rank.assign(n, 0);
+    std::size_t order{0};
+    while (!queue.empty()) {
+      std::ranges::pop_heap(queue, std::greater{});
+      const auto v = queue.back().second;
+      queue.pop_back();
+
+      if (const auto fresh = priority(v);
+          !queue.empty() && fresh > queue.front().first) {
+        queue.emplace_back(fresh, v);
+        std::ranges::push_heap(queue, std::greater{});
+        continue;
+      }
+
+      // `shortcuts` holds the ones of `v` computed by `priority`
+      for (const auto& [u, x, w] : shortcuts) {
+        add_arc(u, x, w, v);
+      }
+      _rank[v] = order++;
+      const auto is_v = [v](const Arc& a) { return a.target == v; };
+      for (const auto& a : out[v]) {
+        ++deleted[a.target];
+        std::erase_if(in[a.target], is_v);
+      }
+      for (const auto& a : in[v]) {
+        ++deleted[a.target];
+        std::erase_if(out[a.target], is_v);
+      }
+      up[v] = std::move(out[v]);
+      down[v] = std::move(in[v]);
+    }
+
+    _shortcut_size = 0;
+    for (const auto& row : up) {
+      _shortcut_size += static_cast<std::size_t>(std::ranges::count_if(
+          row, [](const Arc& a) { return a.middle != none; }));
+    }
+    for (const auto& row : down) {
+      _shortcut_size += static_cast<std::size_t>(std::ranges::count_if(
+          row, [](const Arc& a) { return a.middle != none; }));
+    }
+    Flatten(up, _up_offsets, _up_arcs);
+    Flatten(down, _down_offsets, _down_arcs);
+  }
+
+  static void Flatten(const std::vector<std::vector<Arc>>& rows,
+                      std::vector<std::size_t>& offsets,
+                      std::vector<Arc>& arcs) {
+    offsets.assign(1, 0);
+    for (const auto& row : rows) {
+      arcs.insert(arcs.end(), row.begin(), row.end());
+      offsets.push_back(arcs.size());
+    }
+  }
+
+  /*!
+   * @brief Find the arc from `u` to `v` of the hierarchy
+   */
+  [[nodiscard]] const Arc& FindArc(const std::size_t u,
+                                   const std::size_t v) const {
+    if (_rank[u] < _rank[v]) {
+      return *std::find_if(
+          _up_arcs.begin() + static_cast<std::ptrdiff_t>(_up_offsets[u]),
+          _up_arcs.begin() + static_cast<std::ptrdiff_t>(_up_offsets[u + 1]),
+          [v](const Arc& a) { return a.target == v; });
+    }
+    return *std::find_if(
+        _down_arcs.begin() + static_cast<std::ptrdiff_t>(_down_offsets[v]),
+        _down_arcs.begin() + static_cast<std::ptrdiff_t>(_down_offsets[v + 1]),
+        [u](const Arc& a) { return a.target == u; });
+  }
+
+  /*!
+   * @brief Append the original nodes after `u` up to `v` of an arc
+   */
+  void Unpack(const std::size_t u, const std::size_t v,
+              std::vector<std::size_t>& path) const {
+    std::vector<std::pair<std::size_t, std::size_t>> stack{{u, v}};
+    while (!stack.empty()) {
+      const auto [x, y] = stack.back();
+      stack.pop_back();
+      if (const auto mid = FindArc(x, y).middle; mid != none) {
+        stack.emplace_back(mid, y);
+        stack.emplace_back(x, mid);
+      } else {
+        path.push_back(y);
+      }
+    }
+  }
+
+  /*!
+   * @brief Check a loaded hierarchy so that queries stay in bounds
+   * @throw std::runtime_error if it is malformed
+   */
+  void Validate() const {
+    const auto n = _nodes.size();
+    const auto fail = [] {
+      throw std::runtime_error("Malformed contraction hierarchy");
+    };
+
+    // Ranks are a permutation
+    std::vector<bool> ranked(n, false);
+    for (const auto r : _rank) {
+      if (r >= n || ranked[r]) {
+        fail();
+      }
+      ranked[r] = true;
+    }
+
+    // Both sides hold arcs from a node to higher ranks
+    const auto check_rows = [&](const std::vector<std::size_t>& offsets,
+                                const std::vector<Arc>& arcs) {
+      if (offsets.front() != 0 || !std::ranges::is_sorted(offsets)) {
+        fail();
+      }
+      for (std::size_t v = 0; v < n; ++v) {
+        for (auto k = offsets[v]; k < offsets[v + 1]; ++k) {
+          const auto& a = arcs[k];
+          if (a.target >= n || _rank[a.target] <= _rank[v] ||
+              (a.middle != none && a.middle >= n)) {
+            fail();
+          }
+        }
+      }
+    };
+    check_rows(_up_offsets, _up_arcs);
+    check_rows(_down_offsets, _down_arcs);
+
+    // Shortcuts skip a lower node and both halves exist, so `Unpack` ends
+    const auto has_arc = [this](const std::size_t u, const std::size_t v) {
+      const auto up = _rank[u] < _rank[v];
+      const auto& offsets = up ? _up_offsets : _down_offsets;
+      const auto& arcs = up ? _up_arcs : _down_arcs;
+      const auto from = up ? u : v;
+      const auto to = up ? v : u;
+      return std::any_of(
+          arcs.begin() + static_cast<std::ptrdiff_t>(offsets[from]),
+          arcs.begin() + static_cast<std::ptrdiff_t>(offsets[from + 1]),
+          [to](const Arc& a) { return a.target == to; });
+    };
+    std::size_t shortcuts{0};
+    const auto check_shortcuts = [&](const std::vector<std::size_t>& offsets,
+                                     const std::vector<Arc>& arcs,
+                                     const bool up) {
+      for (std::size_t v = 0; v < n; ++v) {
+        for (auto k = offsets[v]; k < offsets[v + 1]; ++k) {
+          const auto m = arcs[k].middle;
+          if (m == none) {
+            continue;
+          }
+          ++shortcuts;
+          // Arc from `x` to `y` in the direction of the original path
+          const auto x = up ? v : arcs[k].target;
+          const auto y = up ? arcs[k].target : v;
+          if (_rank[m] >= _rank[v] || !has_arc(x, m) || !has_arc(m, y)) {
+            fail();
+          }
+        }
+      }
+    };
+    check_shortcuts(_up_offsets, _up_arcs, true);
+    check_shortcuts(_down_offsets, _down_arcs, false);
+    if (shortcuts != _shortcut_size) {
+      fail();
+    }
+  }
+
+  [[nodiscard]] std::size_t Index(const NodePtr& n) const {
+    if (const auto it = _index.find(n->Id()); it != _index.end()) {
+      return it->second;
+    }
+    return none;
+  }
+
+  template <typename T> static void Write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  static void WriteVector(std::ostream& out, const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(reinterpret_cast<const char*>(values.data()),
+              static_cast<std::streamsize>(values.size() * sizeof(T)));
+  }
+
+  template <typename T> static T Read(std::istream& in) {
+    T value{};
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+      throw std::runtime_error("Truncated contraction hierarchy");
+    }
+    return value;
+  }
+
+  /*!
+   * @brief Get size of bytes left in the stream
+   * @return Size of bytes, max if the stream cannot seek
+   */
+  static std::size_t Remaining(std::istream& in) {
+    const auto pos = in.tellg();
+    if (pos == std::istream::pos_type(-1)) {
+      return std::numeric_limits<std::size_t>::max();
+    }
+    in.seekg(0, std::ios::end);
+    const auto end = in.tellg();
+    in.seekg(pos);
+    return static_cast<std::size_t>(end - pos);
+  }
+
+  template <typename T>
+  static void ReadVector(std::istream& in, std::vector<T>& values,
+                         const std::size_t size) {
+    // Sizes come from the stream, check them before allocating
+    if (size > Remaining(in) / sizeof(T)) {
+      throw std::runtime_error("Truncated contraction hierarchy");
+    }
+    values.resize(size);
+    if (!in.read(reinterpret_cast<char*>(values.data()),
+                 static_cast<std::streamsize>(size * sizeof(T)))) {
+      throw std::runtime_error("Truncated contraction hierarchy");
+    }
+  }
+
+  //! @brief Nodes ordered by dense index
+  std::vector<NodePtr> _nodes;
+
+  //! @brief Node id to dense index
+  std::unordered_map<std::size_t, std::size_t> _index;
+
+  //! @brief Contraction rank of every node
+  std::vector<std::size_t> _rank;
+
+  //! @brief Size of shortcuts
+  std::size_t _shortcut_size{0};
+
+  //! @brief Upward arcs offsets
+  std::vector<std::size_t> _up_offsets;
+
+  //! @brief Upward arcs (towards higher ranks)
+  std::vector<Arc> _up_arcs;
+
+  //! @brief Downward arcs offsets, indexed by the lower node
+  std::vector<std::size_t> _down_offsets;
+
+  //! @brief Downward arcs, `target` is the higher source of the arc
+  std::vector<Arc> _down_arcs;
+};
+
+} // namespace xgraph::algorithm
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/parallel.hpp"
+#include "structure/type_traits.hpp"
+
+namespace xgraph::algorithm {
+
+//! @brief Degree peeled by the core decomposition of a directed graph
+enum class CoreDegree : std::uint8_t {
+  //! @brief In degree
+  In,
+  //! @brief Out degree
+  Out,
+  //! @brief Sum of in and out degrees
+  Total,
+};
+
+namespace detail {
+
+/*!
+ * @brief Degree of a node, undirected graphs always use their out rows
+ * @param csr Graph snapshot
+ * @param v Dense index
+ * @param mode Degree kind
+ * @return Degree
+ */
+template <NodeType Node, EdgeType Edge>
+std::size_t CoreDegreeOf(const CSRGraph<Node, Edge>& csr, const std::size_t v,
+                         const CoreDegree mode) {
+  if (!csr.IsDirected() || mode == CoreDegree::Out) {
+    return csr.OutDegree(v);
+  }
+  if (mode == CoreDegree::In) {
+    return csr.InDegree(v);
+  }
+  return csr.OutDegree(v) + csr.InDegree(v);
+}
+
+/*!
+ * @brief Call `func(u)` once per arc whose removal with `v` lowers the degree
+ * of `u`
+ * @param csr Graph snapshot
+ * @param v Dense index of removed node
+ * @param mode Degree kind
+ * @param func Callable on dense index
+ */
+template <NodeType Node, EdgeType Edge, typename Func>
+void ForEachPeeled(const CSRGraph<Node, Edge>& csr, const std::size_t v,
+                   const CoreDegree mode, Func&& func) {
+  // Out degrees drop at predecessors, in degrees at successors
+  if (!csr.IsDirected() || mode != CoreDegree::Out) {
+    for (const auto u : csr.OutNeighbors(v)) {
+      func(u);
+    }
+  }
+  if (csr.IsDirected() && mode != CoreDegree::In) {
+    for (const auto u : csr.InNeighbors(v)) {
+      func(u);
+    }
+  }
+}
+
+//! @brief Size of frontiers below which a round is peeled on one thread
+inline constexpr std::size_t PEEL_CUTOFF = 1024;
+
+} // namespace detail
+
+/*!
+ * @brief Core number of every node by bucket peeling (Batagelj-Zaversnik)
+ *
+ * Runs in O(nodes + edges). Self loops and parallel edges count in degrees.
+ *
+ * @param csr Graph snapshot
+ * @param mode Degree kind of directed graphs
+ * @return Core number of every dense index
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t>
+CoreNumbers(const CSRGraph<Node, Edge>& csr,
+            const CoreDegree mode = CoreDegree::Total) {
+  const auto n = csr.NodeSize();
+  std::vector<std::size_t> degree(n);
+  std::size_t max_degree{0};
+  for (std::size_t v = 0; v < n; ++v) {
+    degree[v] = detail::CoreDegreeOf(csr, v, mode);
+    max_degree = std::max(max_degree, degree[v]);
+  }
+
+  // Nodes sorted by degree, `bin[d]` being the start of degree `d`
+  std::vector<std::size_t> bin(max_degree + 2, 0);
+  for (const auto d : degree) {
+    ++bin[d + 1];
+  }
+  for (std::size_t d = 0; d <= max_degree; ++d) {
+    bin[d + 1] += bin[d];
+  }
+  std::vector<std::size_t> order(n);
+  std::vector<std::size_t> position(n);
+  {
+    auto cursor = bin;
+    for (std::size_t v = 0; v < n; ++v) {
+      position[v] = cursor[degree[v]]++;
+      order[position[v]] = v;
+    }
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto v = order[i];
+    detail::ForEachPeeled(csr, v, mode, [&](const std::size_t u) {
+      if (degree[u] <= degree[v]) {
+        return;
+      }
+      // Move `u` to the front of its bucket, then shrink the bucket
+      const auto du = degree[u];
+      const auto front = bin[du];
+      const auto w = order[front];
+      std::swap(order[front], order[position[u]]);
+      position[w] = position[u];
+      position[u] = front;
+      ++bin[du];
+      --degree[u];
+    });
+  }
+  return degree;
+}
+
+/*!
+ * @brief Core number of every node by bucket peeling
+ * @param graph Graph
+ * @param mode Degree kind of directed graphs
+ * @return Core number of every dense index of `CSRGraph(graph)` (node id
+ * order)
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t>
+CoreNumbers(const DiGraph<Node, Edge>& graph,
+            const CoreDegree mode = CoreDegree::Total) {
+  return CoreNumbers(CSRGraph<Node, Edge>(graph), mode);
+}
+
+/*!
+ * @brief Core number of every node by level-synchronous parallel peeling
+ *
+ * Level `k` removes all nodes of degree at most `k` in rounds, each round
+ * peeling its frontier in parallel with atomic degree updates. Nodes whose
+ * degree falls to `k` form the next round. Levels without such nodes are
+ * skipped. Workers are started once for all rounds, and frontiers smaller
+ * than `detail::PEEL_CUTOFF` are peeled on the calling thread.
+ *
+ * @param csr Graph snapshot
+ * @param mode Degree kind of directed graphs
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Core number of every dense index, same as `CoreNumbers`
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t>
+ParallelCoreNumbers(const CSRGraph<Node, Edge>& csr,
+                    const CoreDegree mode = CoreDegree::Total,
+                    const std::size_t threads = 0) {
+  constexpr auto npos = CSRGraph<Node, Edge>::npos;
+  const auto n = csr.NodeSize();
+  std::vector<std::size_t> degree(n);
+  for (std::size_t v = 0; v < n; ++v) {
+    degree[v] = detail::CoreDegreeOf(csr, v, mode);
+  }
+  std::vector<std::size_t> core(n, npos);
+
+  std::vector<std::size_t> alive(n);
+  std::iota(alive.begin(), alive.end(), 0);
+  utils::WorkerPool pool(
+      std::min(utils::WorkerCount(threads), std::max<std::size_t>(n, 1)));
+  std::vector<std::vector<std::size_t>> next(pool.Size());
+  std::vector<std::size_t> frontier;
+  std::size_t k{0};
+  while (!alive.empty()) {
+    // Jump to the lowest degree left
+    k = std::max(k, std::ranges::min(alive | std::views::transform(
+                                                 [&degree](std::size_t v) {
+                                                   return degree[v];
+                                                 })));
+    frontier.clear();
+    for (const auto v : alive) {
+      if (degree[v] <= k) {
+        frontier.push_back(v);
+      }
+    }
+
+    while (!frontier.empty()) {
+      for (const auto v : frontier) {
+        core[v] = k;
+      }
+      const auto peel = [&](const std::size_t worker, const std::size_t i) {
+        detail::ForEachPeeled(csr, frontier[i], mode, [&](const std::size_t u) {
+          if (core[u] != npos) {
+            return;
+          }
+          // Degrees never go below `k` while the level lasts
+          std::atomic_ref<std::size_t> du(degree[u]);
+          if (du.load(std::memory_order_relaxed) <= k) {
+            return;
+          }
+          const auto old = du.fetch_sub(1, std::memory_order_relaxed);
+          if (old == k + 1) {
+            next[worker].push_back(u);
+          } else if (old <= k) {
+            du.fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+      };
+      if (frontier.size() < detail::PEEL_CUTOFF) {
+        for (std::size_t i = 0; i < frontier.size(); ++i) {
+          peel(0, i);
+        }
+      } else {
+        pool.ParallelFor(frontier.size(), peel);
+      }
+
+      frontier.clear();
+      for (auto& part : next) {
+        frontier.insert(frontier.end(), part.begin(), part.end());
+        part.clear();
+      }
+    }
+
+    std::erase_if(alive, [&core](const std::size_t v) {
+      return core[v] != npos;
+    });
+    ++k;
+  }
+  return core;
+}
+
+/*!
+ * @brief Core number of every node by level-synchronous parallel peeling
+ * @param graph Graph
+ * @param mode Degree kind of directed graphs
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Core number of every dense index of `CSRGraph(graph)` (node id
+ * order)
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t>
+ParallelCoreNumbers(const DiGraph<Node, Edge>& graph,
+                    const CoreDegree mode = CoreDegree::Total,
+                    const std::size_t threads = 0) {
+  return ParallelCoreNumbers(CSRGraph<Node, Edge>(graph), mode, threads);
+}
+
+/*!
+ * @brief Extract the k-core of a snapshot
+ * @param csr Graph snapshot
+ * @param cores Core numbers returned by `CoreNumbers`
+ * @param k Core order
+ * @return Subgraph induced by the nodes of core number at least `k`, sharing
+ * node and edge pointers with `csr`
+ */
+template <NodeType Node, EdgeType Edge>
+CSRGraph<Node, Edge> ExtractCore(const CSRGraph<Node, Edge>& csr,
+                                 const std::vector<std::size_t>& cores,
+                                 const std::size_t k) {
+  std::vector<std::size_t> kept;
+  for (std::size_t v = 0; v < csr.NodeSize(); ++v) {
+    if (cores[v] >= k) {
+      kept.push_back(v);
+    }
+  }
+  return csr.Subgraph(kept);
+}
+
+/*!
+ * @brief Extract the k-core of a graph
+ * @param graph Graph
+ * @param k Core order
+ * @param mode Degree kind of directed graphs
+ * @return Snapshot of the subgraph induced by the nodes of core number at
+ * least `k`
+ */
+template <NodeType Node, EdgeType Edge>
+CSRGraph<Node, Edge> ExtractCore(const DiGraph<Node, Edge>& graph,
+                                 const std::size_t k,
+                                 const CoreDegree mode = CoreDegree::Total) {
+  const CSRGraph<Node, Edge> csr(graph);
+  return ExtractCore(csr, CoreNumbers(csr, mode), k);
+}
+
+} // namespace xgraph::algorithm
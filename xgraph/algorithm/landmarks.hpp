@@ -0,0 +1,431 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algorithm/shortest_path.hpp"
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/parallel.hpp"
+#include "structure/type_traits.hpp"
+
+namespace xgraph::algorithm {
+
+//! @brief Landmark selection strategy of `Landmarks`
+enum class LandmarkSelection : std::uint8_t {
+  //! @brief Node farthest from the landmarks chosen so far
+  Farthest,
+  //! @brief Leaf of the worst covered branch of a shortest path tree (Avoid)
+  Avoid,
+};
+
+namespace detail {
+
+//! @brief Weighted adjacency rows of one direction
+struct LandmarkRows {
+  std::vector<std::size_t> offsets;
+  std::vector<std::pair<std::size_t, double>> arcs;
+};
+
+/*!
+ * @brief Dijkstra over adjacency rows
+ * @param rows Adjacency rows
+ * @param source Dense index of source
+ * @param dist Distance of every node (infinity if unreachable)
+ * @param parent Parent of every reached node in the shortest path tree
+ * @param order Reached nodes in settle order
+ */
+inline void LandmarkDijkstra(const LandmarkRows& rows, const std::size_t source,
+                             std::vector<double>& dist,
+                             std::vector<std::size_t>& parent,
+                             std::vector<std::size_t>& order) {
+  const auto n = rows.offsets.size() - 1;
+  dist.assign(n, std::numeric_limits<double>::infinity());
+  parent.assign(n, n);
+  order.clear();
+
+  std::vector<std::pair<double, std::size_t>> heap{{0.0, source}};
+  dist[source] = 0.0;
+  while (!heap.empty()) {
+    std::ranges::pop_heap(heap, std::greater{});
+    const auto [d, v] = heap.back();
+    heap.pop_back();
+    if (d > dist[v]) {
+      continue;
+    }
+    order.push_back(v);
+    for (auto k = rows.offsets[v]; k < rows.offsets[v + 1]; ++k) {
+      const auto [w, cost] = rows.arcs[k];
+      if (d + cost < dist[w]) {
+        dist[w] = d + cost;
+        parent[w] = v;
+        heap.emplace_back(dist[w], w);
+        std::ranges::push_heap(heap, std::greater{});
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/*!
+ * @brief Landmark distance tables for A* (ALT heuristic)
+ *
+ * Distances from and to every landmark are kept as `float`, node-major so
+ * the bounds of one node are contiguous. By the triangle inequality, for
+ * every landmark `L`, `d(v, t) >= d(v, L) - d(t, L)` and
+ * `d(v, t) >= d(L, t) - d(L, v)`, so the largest bound is an admissible
+ * estimate on any weighted graph. Bounds are lowered by the rounding error
+ * of `float` and bounds through a landmark that one of the nodes cannot
+ * reach are skipped.
+ *
+ * Weights are read as `double` and must not be negative. The tables do not
+ * observe later changes of the graph.
+ *
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node, EdgeType Edge> class Landmarks {
+  using NodePtr = std::shared_ptr<Node>;
+
+  static constexpr std::size_t none = CSRGraph<Node, Edge>::npos;
+
+public:
+  /*!
+   * @brief Select landmarks and compute their distance tables
+   * @param csr Graph snapshot
+   * @param count Size of landmarks (at most the size of nodes)
+   * @param selection Selection strategy
+   * @throw std::invalid_argument if a weight is negative
+   */
+  Landmarks(const CSRGraph<Node, Edge>& csr, const std::size_t count,
+            const LandmarkSelection selection = LandmarkSelection::Avoid)
+      : _size(csr.NodeSize()), _stride(std::min(count, csr.NodeSize())) {
+    BuildLookup(csr);
+    const auto [forward, backward] = Rows(csr);
+
+    _from.assign(_size * _stride, 0.0F);
+    _to.assign(_size * _stride, 0.0F);
+
+    std::vector<double> from;
+    std::vector<double> to;
+    std::vector<std::size_t> parent;
+    std::vector<std::size_t> order;
+
+    // Distance to the closest landmark in either direction, seeded from
+    // dense index 0 so the first landmark is far from it
+    std::vector<double> cover(_size, std::numeric_limits<double>::infinity());
+    const auto update_cover = [&] {
+      for (std::size_t v = 0; v < _size; ++v) {
+        cover[v] = std::min({cover[v], from[v], to[v]});
+      }
+    };
+    if (_stride != 0) {
+      detail::LandmarkDijkstra(forward, 0, from, parent, order);
+      detail::LandmarkDijkstra(backward, 0, to, parent, order);
+      update_cover();
+    }
+
+    std::minstd_rand rng(1);
+    std::vector<bool> is_landmark(_size, false);
+    for (std::size_t i = 0; i < _stride; ++i) {
+      auto landmark = none;
+      if (selection == LandmarkSelection::Avoid && i != 0) {
+        landmark = AvoidLandmark(forward, rng() % _size, is_landmark);
+      }
+      if (landmark == none) {
+        // Unreached nodes come first, so every component gets a landmark
+        landmark = static_cast<std::size_t>(std::ranges::distance(
+            cover.begin(), std::ranges::max_element(cover)));
+      }
+
+      is_landmark[landmark] = true;
+      _landmarks.push_back(landmark);
+      _landmark_nodes.push_back(csr.GetNode(landmark));
+      detail::LandmarkDijkstra(forward, landmark, from, parent, order);
+      detail::LandmarkDijkstra(backward, landmark, to, parent, order);
+      for (std::size_t v = 0; v < _size; ++v) {
+        _from[v * _stride + i] = static_cast<float>(from[v]);
+        _to[v * _stride + i] = static_cast<float>(to[v]);
+      }
+      update_cover();
+      cover[landmark] = -1.0;
+    }
+  }
+
+  /*!
+   * @brief Select landmarks of the snapshot of a graph
+   * @param graph Graph
+   * @param count Size of landmarks (at most the size of nodes)
+   * @param selection Selection strategy
+   * @throw std::invalid_argument if a weight is negative
+   */
+  Landmarks(const DiGraph<Node, Edge>& graph, const std::size_t count,
+            const LandmarkSelection selection = LandmarkSelection::Avoid)
+      : Landmarks(CSRGraph<Node, Edge>(graph), count, selection) {}
+
+  /*!
+   * @brief Get size of landmarks
+   * @return Size of landmarks
+   */
+  [[nodiscard]] std::size_t Size() const { return _landmarks.size(); }
+
+  /*!
+   * @brief Get size of nodes of the snapshot
+   * @return Size of nodes
+   */
+  [[nodiscard]] std::size_t NodeSize() const { return _size; }
+
+  /*!
+   * @brief Get a landmark
+   * @param i Position in `[0, Size())`
+   * @return Node ptr
+   */
+  const NodePtr& GetLandmark(const std::size_t i) const {
+    return _landmark_nodes[i];
+  }
+
+  /*!
+   * @brief Lower bound of the cost of a path
+   * @param v Dense index of the first node
+   * @param t Dense index of the last node
+   * @return Admissible estimate
+   */
+  [[nodiscard]] double Estimate(const std::size_t v,
+                                const std::size_t t) const {
+    constexpr double inf = std::numeric_limits<float>::infinity();
+    const auto bound = [](const double lhs, const double rhs) {
+      return lhs == inf || rhs == inf ? 0.0
+                                      : lhs - rhs - (lhs + rhs) * FLT_EPSILON;
+    };
+    const auto* to_v = _to.data() + v * _stride;
+    const auto* to_t = _to.data() + t * _stride;
+    const auto* from_v = _from.data() + v * _stride;
+    const auto* from_t = _from.data() + t * _stride;
+    double best{0.0};
+    for (std::size_t i = 0; i < _landmarks.size(); ++i) {
+      best = std::max({best, bound(to_v[i], to_t[i]),
+                       bound(from_t[i], from_v[i])});
+    }
+    return best;
+  }
+
+  /*!
+   * @brief Heuristic for `AStarPath` and `AStarPaths`
+   *
+   * Node ids are mapped to dense indices by a direct table when ids are
+   * small and by binary search otherwise, without hashing. Nodes that are
+   * not in the snapshot get 0. The landmarks must outlive the heuristic.
+   *
+   * @return Heuristic
+   */
+  [[nodiscard]] Heuristic_t<Node> Heuristic() const {
+    return [this](const NodePtr& n, const NodePtr& t) {
+      const auto v = Lookup(n->Id());
+      const auto u = Lookup(t->Id());
+      return v == none || u == none ? 0.0 : Estimate(v, u);
+    };
+  }
+
+private:
+  /*!
+   * @brief Weighted out rows and reversed (in) rows of a snapshot
+   * @throw std::invalid_argument if a weight is negative
+   */
+  static std::pair<detail::LandmarkRows, detail::LandmarkRows>
+  Rows(const CSRGraph<Node, Edge>& csr) {
+    const auto n = csr.NodeSize();
+    detail::LandmarkRows forward;
+    detail::LandmarkRows backward;
+    forward.offsets.assign(1, 0);
+    backward.offsets.assign(n + 1, 0);
+    forward.arcs.reserve(csr.EdgeSize());
+    for (std::size_t s = 0; s < n; ++s) {
+      const auto row = csr.OutNeighbors(s);
+      for (std::size_t k = 0; k < row.size(); ++k) {
+        double w{1.0};
+        if constexpr (!IsUnweighted_v<Edge>) {
+          w = static_cast<double>(csr.OutWeights(s)[k]);
+        }
+        if (w < 0) {
+          throw std::invalid_argument("Negative edge weight");
+        }
+        forward.arcs.emplace_back(row[k], w);
+        ++backward.offsets[row[k] + 1];
+      }
+      forward.offsets.push_back(forward.arcs.size());
+    }
+
+    for (std::size_t v = 0; v < n; ++v) {
+      backward.offsets[v + 1] += backward.offsets[v];
+    }
+    backward.arcs.resize(forward.arcs.size());
+    auto next = backward.offsets;
+    for (std::size_t s = 0; s < n; ++s) {
+      for (auto k = forward.offsets[s]; k < forward.offsets[s + 1]; ++k) {
+        const auto [t, w] = forward.arcs[k];
+        backward.arcs[next[t]++] = {s, w};
+      }
+    }
+    return {std::move(forward), std::move(backward)};
+  }
+
+  /*!
+   * @brief Avoid selection (Goldberg and Werneck)
+   *
+   * Nodes of the shortest path tree from `root` are weighted by how much
+   * the current landmarks underestimate their distance, subtrees holding a
+   * landmark weigh nothing, and the tree is descended along the heaviest
+   * subtree down to a leaf.
+   *
+   * @return Dense index of the leaf, `npos` if every branch is covered
+   */
+  std::size_t AvoidLandmark(const detail::LandmarkRows& forward,
+                            const std::size_t root,
+                            const std::vector<bool>& is_landmark) const {
+    std::vector<double> dist;
+    std::vector<std::size_t> parent;
+    std::vector<std::size_t> order;
+    detail::LandmarkDijkstra(forward, root, dist, parent, order);
+
+    std::vector<double> weight(_size, 0.0);
+    std::vector<bool> covered(_size, false);
+    for (const auto v : order) {
+      weight[v] = std::max(dist[v] - Estimate(root, v), 0.0);
+      covered[v] = is_landmark[v];
+    }
+    // Children are settled after their parent
+    for (const auto v : order | std::views::reverse) {
+      if (v == root) {
+        continue;
+      }
+      if (covered[v]) {
+        covered[parent[v]] = true;
+      } else {
+        weight[parent[v]] += weight[v];
+      }
+    }
+    const auto size = [&](const std::size_t v) {
+      return covered[v] ? 0.0 : weight[v];
+    };
+
+    std::vector<std::size_t> heaviest(_size, none);
+    for (const auto v : order) {
+      if (v != root && size(v) > 0.0 &&
+          (heaviest[parent[v]] == none ||
+           size(v) > size(heaviest[parent[v]]))) {
+        heaviest[parent[v]] = v;
+      }
+    }
+    if (size(root) <= 0.0 || heaviest[root] == none) {
+      return none;
+    }
+    auto v = root;
+    while (heaviest[v] != none) {
+      v = heaviest[v];
+    }
+    return v;
+  }
+
+  //! @brief Build the id to dense index lookup
+  void BuildLookup(const CSRGraph<Node, Edge>& csr) {
+    std::size_t max_id{0};
+    for (std::size_t i = 0; i < _size; ++i) {
+      max_id = std::max(max_id, csr.GetNode(i)->Id());
+    }
+    if (_size != 0 && max_id < 4 * _size) {
+      _direct.assign(max_id + 1, none);
+      for (std::size_t i = 0; i < _size; ++i) {
+        _direct[csr.GetNode(i)->Id()] = i;
+      }
+      return;
+    }
+    _sorted.reserve(_size);
+    for (std::size_t i = 0; i < _size; ++i) {
+      _sorted.emplace_back(csr.GetNode(i)->Id(), i);
+    }
+    std::ranges::sort(_sorted);
+  }
+
+  [[nodiscard]] std::size_t Lookup(const std::size_t id) const {
+    if (!_direct.empty()) {
+      return id < _direct.size() ? _direct[id] : none;
+    }
+    const auto it = std::ranges::lower_bound(
+        _sorted, id, {}, &std::pair<std::size_t, std::size_t>::first);
+    return it != _sorted.end() && it->first == id ? it->second : none;
+  }
+
+  //! @brief Size of nodes
+  std::size_t _size;
+
+  //! @brief Size of landmarks a node row holds
+  std::size_t _stride;
+
+  //! @brief Dense index of every landmark
+  std::vector<std::size_t> _landmarks;
+
+  //! @brief Node ptr of every landmark
+  std::vector<NodePtr> _landmark_nodes;
+
+  //! @brief Distance from landmark `i` to node `v` at `v * _stride + i`
+  std::vector<float> _from;
+
+  //! @brief Distance from node `v` to landmark `i` at `v * _stride + i`
+  std::vector<float> _to;
+
+  //! @brief Dense index of every id when ids are small
+  std::vector<std::size_t> _direct;
+
+  //! @brief (id, dense index) sorted by id otherwise
+  std::vector<std::pair<std::size_t, std::size_t>> _sorted;
+};
+
+/*!
+ * @brief Shortest paths of many queries in parallel, guided by landmarks
+ *
+ * Same as `AStarPaths` with `landmarks.Heuristic()`, but bounds are read by
+ * dense index without going through node ptrs.
+ *
+ * @param csr Graph snapshot the landmarks were built from
+ * @param queries (source, target) pairs
+ * @param landmarks Landmarks
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Result of every query in input order
+ * @throw std::invalid_argument if the landmarks belong to another snapshot
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<PathResult<Node>>
+AStarPaths(const CSRGraph<Node, Edge>& csr,
+           std::type_identity_t<std::span<const PathQuery_t<Node>>> queries,
+           const Landmarks<Node, Edge>& landmarks,
+           const std::size_t threads = 0) {
+  if (landmarks.NodeSize() != csr.NodeSize()) {
+    throw std::invalid_argument("Landmarks of another snapshot");
+  }
+  std::vector<PathResult<Node>> res(queries.size());
+  std::vector<Workspace> workspaces(utils::WorkerCount(threads));
+  const auto estimate = [&landmarks](const std::size_t v, const std::size_t t) {
+    return landmarks.Estimate(v, t);
+  };
+  utils::ParallelFor(
+      queries.size(), threads,
+      [&](const std::size_t worker, const std::size_t i) {
+        const auto& [source, target] = queries[i];
+        detail::CSRAStarPath(csr, csr.Index(source), csr.Index(target),
+                             estimate, workspaces[worker], res[i]);
+      });
+  return res;
+}
+
+} // namespace xgraph::algorithm
@@ -0,0 +1,172 @@
+#pragma once
+
+// Lazy traversals need coroutine generators, they are left out on standard
+// libraries without `std::generator`
+#include <version>
+
+#if defined(__cpp_lib_generator)
+
+#include <generator>
+#include <memory>
+#include <queue>
+#include <stack>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algorithm/traversal.hpp"
+#include "structure/graph.hpp"
+#include "structure/type_traits.hpp"
+#include "structure/visited_set.hpp"
+
+namespace xgraph::algorithm {
+
+/*!
+ * @brief Node reached by a lazy traversal
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node, EdgeType Edge> struct TraversalStep {
+  //! @brief Reached node
+  std::shared_ptr<Node> node;
+
+  //! @brief Edges from the start node (generation for topological sort)
+  std::size_t depth{0};
+
+  //! @brief Node it was reached from (nullptr for start nodes)
+  std::shared_ptr<Node> parent;
+
+  //! @brief Edge it was reached through (nullptr for start nodes)
+  std::shared_ptr<Edge> edge;
+};
+
+/*!
+ * @brief Lazy breadth first search, a node is expanded only after it was
+ * consumed
+ * @note The graph must outlive the generator and not change while iterating
+ * @param graph Graph
+ * @param start Start node, nothing is yielded if it is not in the graph
+ * @return Generator of steps in visit order
+ */
+template <NodeType Node, EdgeType Edge>
+std::generator<const TraversalStep<Node, Edge>&>
+LazyBFS(const DiGraph<Node, Edge>& graph, std::shared_ptr<Node> start) {
+  const auto slot = graph.Slot(start->Id());
+  if (slot == DiGraph<Node, Edge>::npos) {
+    co_return;
+  }
+  utils::VisitedSet visited;
+  visited.Reset(graph.SlotSize());
+  visited.Insert(slot);
+  std::queue<TraversalStep<Node, Edge>> q;
+  q.push({std::move(start), 0, nullptr, nullptr});
+
+  while (!q.empty()) {
+    const auto step = std::move(q.front());
+    q.pop();
+    co_yield step;
+
+    detail::ForEachNeighbor(
+        graph, step.node,
+        [&](const std::shared_ptr<Node>& n, const std::shared_ptr<Edge>& e) {
+          if (visited.Insert(graph.Slot(n->Id()))) {
+            q.push({n, step.depth + 1, step.node, e});
+          }
+        });
+  }
+}
+
+/*!
+ * @brief Lazy depth first search, a node is expanded only after it was
+ * consumed
+ * @note The graph must outlive the generator and not change while iterating
+ * @param graph Graph
+ * @param start Start node, nothing is yielded if it is not in the graph
+ * @return Generator of steps in visit order
+ */
+template <NodeType Node, EdgeType Edge>
+std::generator<const TraversalStep<Node, Edge>&>
+LazyDFS(const DiGraph<Node, Edge>& graph, std::shared_ptr<Node> start) {
+  if (graph.Slot(start->Id()) == DiGraph<Node, Edge>::npos) {
+    co_return;
+  }
+  utils::VisitedSet visited;
+  visited.Reset(graph.SlotSize());
+  std::stack<TraversalStep<Node, Edge>> s;
+  s.push({std::move(start), 0, nullptr, nullptr});
+
+  while (!s.empty()) {
+    const auto step = std::move(s.top());
+    s.pop();
+
+    if (!visited.Insert(graph.Slot(step.node->Id()))) {
+      continue;
+    }
+    co_yield step;
+
+    detail::ForEachNeighbor(
+        graph, step.node,
+        [&](const std::shared_ptr<Node>& n, const std::shared_ptr<Edge>& e) {
+          if (!visited.Contains(graph.Slot(n->Id()))) {
+            s.push({n, step.depth + 1, step.node, e});
+          }
+        });
+  }
+}
+
+/*!
+ * @brief Lazy topological sort by generations of zero in degree nodes
+ * @note The graph must outlive the generator
+ * @param graph Graph
+ * @return Generator of steps, `depth` is the generation and `parent` the
+ * node whose edge was the last one left into the node
+ * @throw std::runtime_error once the acyclic part is exhausted if the graph
+ * contains a cycle, or if the graph changed during iteration
+ */
+template <NodeType Node, EdgeType Edge>
+std::generator<const TraversalStep<Node, Edge>&>
+LazyTopologicalSort(const DiGraph<Node, Edge>& graph) {
+  std::vector<std::size_t> indegree(graph.SlotSize(), 0);
+  std::size_t waiting{0};
+  std::vector<TraversalStep<Node, Edge>> zero_indegree;
+  for (const auto& n : graph.Nodes()) {
+    if (const auto indegree_num = graph.InEdgeSize(n->Id());
+        indegree_num == 0) {
+      zero_indegree.push_back({n, 0, nullptr, nullptr});
+    } else {
+      indegree[graph.Slot(n->Id())] = indegree_num;
+      ++waiting;
+    }
+  }
+
+  while (!zero_indegree.empty()) {
+    const auto this_generation = std::move(zero_indegree);
+    zero_indegree.clear();
+    for (const auto& step : this_generation) {
+      co_yield step;
+
+      if (!graph.HasNode(step.node->Id())) {
+        throw std::runtime_error("Graph changed during iteration!");
+      }
+      for (const auto& e : graph.OutEdges(step.node->Id())) {
+        const auto child = e->Target();
+        const auto slot = graph.Slot(child->Id());
+        if (slot == graph.npos || slot >= indegree.size()) {
+          throw std::runtime_error("Graph changed during iteration!");
+        }
+        if (--indegree[slot] == 0) {
+          zero_indegree.push_back({child, step.depth + 1, step.node, e});
+          --waiting;
+        }
+      }
+    }
+  }
+  if (waiting != 0) {
+    throw std::runtime_error(
+        "Graph contains a cycle or graph changed during iteration!");
+  }
+}
+
+} // namespace xgraph::algorithm
+
+#endif
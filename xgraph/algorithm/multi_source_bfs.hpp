@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "structure/csr.hpp"
+#include "structure/type_traits.hpp"
+
+namespace xgraph::algorithm {
+
+namespace detail {
+
+//! @brief One bit per source of a batch
+template <std::size_t Width> using SourceSet =
+    std::array<std::uint64_t, Width / 64>;
+
+template <std::size_t Width>
+[[nodiscard]] bool Any(const SourceSet<Width>& set) {
+  return std::ranges::any_of(set, [](const std::uint64_t w) { return w != 0; });
+}
+
+/*!
+ * @brief MS-BFS of one batch of at most `Width` sources
+ * @param csr Graph snapshot
+ * @param sources Dense indices of the batch
+ * @param offset Position of the first source of the batch
+ * @param func Callable on (source position, dense index, depth)
+ */
+template <std::size_t Width, NodeType Node, EdgeType Edge, typename Func>
+void MultiSourceBatch(const CSRGraph<Node, Edge>& csr,
+                      std::span<const std::size_t> sources,
+                      const std::size_t offset, Func& func) {
+  using Set = SourceSet<Width>;
+  const auto n = csr.NodeSize();
+  std::vector<Set> seen(n, Set{});
+  std::vector<Set> visit(n, Set{});
+  std::vector<Set> visit_next(n, Set{});
+
+  const auto report = [&](const std::size_t v, const Set& set,
+                          const std::size_t depth) {
+    for (std::size_t k = 0; k < set.size(); ++k) {
+      for (auto word = set[k]; word != 0; word &= word - 1) {
+        const auto bit = static_cast<std::size_t>(std::countr_zero(word));
+        func(offset + k * 64 + bit, v, depth);
+      }
+    }
+  };
+
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    seen[sources[i]][i / 64] |= std::uint64_t{1} << i % 64;
+    visit[sources[i]][i / 64] |= std::uint64_t{1} << i % 64;
+  }
+  for (std::size_t v = 0; v < n; ++v) {
+    if (Any<Width>(visit[v])) {
+      report(v, visit[v], 0);
+    }
+  }
+
+  for (std::size_t depth = 1;; ++depth) {
+    // Every frontier node is expanded once for all sources that reached it
+    bool frontier{false};
+    for (std::size_t v = 0; v < n; ++v) {
+      if (!Any<Width>(visit[v])) {
+        continue;
+      }
+      for (const auto w : csr.OutNeighbors(v)) {
+        for (std::size_t k = 0; k < Width / 64; ++k) {
+          visit_next[w][k] |= visit[v][k];
+        }
+      }
+    }
+
+    for (std::size_t v = 0; v < n; ++v) {
+      for (std::size_t k = 0; k < Width / 64; ++k) {
+        visit_next[v][k] &= ~seen[v][k];
+        seen[v][k] |= visit_next[v][k];
+      }
+      if (Any<Width>(visit_next[v])) {
+        frontier = true;
+        report(v, visit_next[v], depth);
+      }
+      visit[v] = Set{};
+    }
+
+    if (!frontier) {
+      return;
+    }
+    std::swap(visit, visit_next);
+  }
+}
+
+} // namespace detail
+
+/*!
+ * @brief Multi-source breadth first search (MS-BFS)
+ *
+ * Sources are processed in batches of `Width`. Every node keeps one bit per
+ * source of the batch, so a node reached by many sources at the same depth
+ * is expanded once for all of them. Out arcs are followed, use the snapshot
+ * of an undirected graph to ignore directions.
+ *
+ * @tparam Width Size of batches, a multiple of 64 up to 512
+ * @param csr Graph snapshot
+ * @param sources Dense indices of sources
+ * @param func Callable on (position of the source in `sources`, dense index
+ * of a reached node, depth), called once per pair in ascending depth
+ */
+template <std::size_t Width = 64, NodeType Node, EdgeType Edge, typename Func>
+  requires(Width % 64 == 0 && Width >= 64 && Width <= 512)
+void MultiSourceBFS(const CSRGraph<Node, Edge>& csr,
+                    std::span<const std::size_t> sources, Func&& func) {
+  for (std::size_t first = 0; first < sources.size(); first += Width) {
+    detail::MultiSourceBatch<Width>(
+        csr, sources.subspan(first, std::min(Width, sources.size() - first)),
+        first, func);
+  }
+}
+
+/*!
+ * @brief Distances from many sources by multi-source breadth first search
+ * @tparam Width Size of batches, a multiple of 64 up to 512
+ * @param csr Graph snapshot
+ * @param sources Dense indices of sources
+ * @return Distance of node `v` from source `i` at `i * NodeSize() + v`,
+ * `CSRGraph::npos` if unreachable
+ */
+template <std::size_t Width = 64, NodeType Node, EdgeType Edge>
+  requires(Width % 64 == 0 && Width >= 64 && Width <= 512)
+std::vector<std::size_t>
+MultiSourceDistances(const CSRGraph<Node, Edge>& csr,
+                     std::span<const std::size_t> sources) {
+  const auto n = csr.NodeSize();
+  std::vector<std::size_t> distances(sources.size() * n,
+                                     CSRGraph<Node, Edge>::npos);
+  MultiSourceBFS<Width>(csr, sources,
+                        [&distances, n](const std::size_t source,
+                                        const std::size_t v,
+                                        const std::size_t depth) {
+                          distances[source * n + v] = depth;
+                        });
+  return distances;
+}
+
+} // namespace xgraph::algorithm
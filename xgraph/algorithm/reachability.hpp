@@ -0,0 +1,299 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "algorithm/components.hpp"
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/type_traits.hpp"
+#include "structure/utils.hpp"
+#include "structure/visited_set.hpp"
+
+namespace xgraph::algorithm {
+
+/*!
+ * @brief Reachability index answering lineage queries without traversal
+ *
+ * The graph is condensed into its strongly connected components and the
+ * transitive closure of the condensation DAG is stored as one bitset per
+ * component, so `CanReach` is a single bit test and `Ancestors` /
+ * `Descendants` only enumerate set bits. The closure costs
+ * 2 * components^2 / 8 bytes whatever the sparsity of the graph, so it is
+ * only built up to a byte budget. Above it the index keeps the snapshot and
+ * components only, and queries fall back to a breadth first search.
+ *
+ * The index keeps a reference to the graph and is rebuilt lazily on the first
+ * query after the graph's `Version()` changed. It is not thread-safe.
+ *
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node, EdgeType Edge> class ReachabilityIndex {
+  using NodePtr = std::shared_ptr<Node>;
+  using NodeSet =
+      std::unordered_set<NodePtr, std::function<std::size_t(const NodePtr&)>,
+                         std::function<bool(const NodePtr&, const NodePtr&)>>;
+  using Bitset = std::vector<std::uint64_t>;
+
+public:
+  //! @brief Default byte budget of the closure
+  static constexpr std::size_t MAX_CLOSURE_BYTES = std::size_t{256} << 20;
+
+  /*!
+   * @brief Constructor (the index is built on first query)
+   * @param graph Indexed graph, must outlive the index
+   * @param max_closure_bytes Byte budget of the closure
+   */
+  explicit ReachabilityIndex(
+      const DiGraph<Node, Edge>& graph,
+      const std::size_t max_closure_bytes = MAX_CLOSURE_BYTES)
+      : _graph(graph), _max_closure_bytes(max_closure_bytes) {}
+
+  /*!
+   * @brief Whether the index is out of date with the graph
+   * @return Boolean
+   */
+  [[nodiscard]] bool IsStale() const {
+    return !_built || _csr.Version() != _graph.Version();
+  }
+
+  /*!
+   * @brief Rebuild the index immediately
+   */
+  void Rebuild() const {
+    _csr = CSRGraph<Node, Edge>(_graph);
+    _component = StronglyConnectedComponents(_csr);
+
+    std::size_t component_num{0};
+    for (const auto c : _component) {
+      component_num = std::max(component_num, c + 1);
+    }
+
+    _members.assign(component_num, {});
+    for (std::size_t i = 0; i < _component.size(); ++i) {
+      _members[_component[i]].push_back(i);
+    }
+
+    const auto words = (component_num + 63) / 64;
+    _closure = 2 * component_num * words * sizeof(std::uint64_t) <=
+               _max_closure_bytes;
+    if (!_closure) {
+      _descendants.clear();
+      _ancestors.clear();
+      _built = true;
+      return;
+    }
+    _descendants.assign(component_num, Bitset(words, 0));
+    _ancestors.assign(component_num, Bitset(words, 0));
+
+    // Components are numbered sinks first, so successors are ready in time
+    for (std::size_t c = 0; c < component_num; ++c) {
+      auto& reach = _descendants[c];
+      for (const auto v : _members[c]) {
+        for (const auto w : _csr.OutNeighbors(v)) {
+          const auto d = _component[w];
+          if (d == c) {
+            // Cycle inside the component: every member reaches itself
+            Set(reach, c);
+            continue;
+          }
+          if (!Test(reach, d)) {
+            Set(reach, d);
+            for (std::size_t k = 0; k < words; ++k) {
+              reach[k] |= _descendants[d][k];
+            }
+          }
+        }
+      }
+    }
+
+    // Transpose the closure
+    for (std::size_t c = 0; c < component_num; ++c) {
+      ForEachBit(_descendants[c], [this, c](const std::size_t d) {
+        Set(_ancestors[d], c);
+      });
+    }
+
+    _built = true;
+  }
+
+  /*!
+   * @brief Whether there is a non-empty path from `u` to `v`
+   * @param u Source node
+   * @param v Target node
+   * @return Boolean (false if any node is not in the graph)
+   */
+  [[nodiscard]] bool CanReach(const NodePtr& u, const NodePtr& v) const {
+    return CanReach(u->Id(), v->Id());
+  }
+
+  /*!
+   * @brief Whether there is a non-empty path from `u` to `v`
+   * @param u_id Source node id
+   * @param v_id Target node id
+   * @return Boolean (false if any node is not in the graph)
+   */
+  [[nodiscard]] bool CanReach(const std::size_t& u_id,
+                              const std::size_t& v_id) const {
+    EnsureFresh();
+    const auto u = _csr.Index(u_id);
+    const auto v = _csr.Index(v_id);
+    if (u == CSRGraph<Node, Edge>::npos || v == CSRGraph<Node, Edge>::npos) {
+      return false;
+    }
+    if (!_closure) {
+      return Search(u, true, [v](const std::size_t w) { return w == v; });
+    }
+    return Test(_descendants[_component[u]], _component[v]);
+  }
+
+  /*!
+   * @brief Get all nodes that can reach the node (same as `Predecessor`)
+   * @param n Node
+   * @return Ancestors nodes
+   */
+  NodeSet Ancestors(const NodePtr& n) const {
+    EnsureFresh();
+    return Collect(_ancestors, false, n);
+  }
+
+  /*!
+   * @brief Get all nodes reachable from the node (same as `Successor`)
+   * @param n Node
+   * @return Descendants nodes
+   */
+  NodeSet Descendants(const NodePtr& n) const {
+    EnsureFresh();
+    return Collect(_descendants, true, n);
+  }
+
+  /*!
+   * @brief Get size of strongly connected components
+   * @return Size of components
+   */
+  [[nodiscard]] std::size_t ComponentSize() const {
+    EnsureFresh();
+    return _members.size();
+  }
+
+  /*!
+   * @brief Whether queries use the closure, false if it is over budget
+   * @return Boolean
+   */
+  [[nodiscard]] bool HasClosure() const {
+    EnsureFresh();
+    return _closure;
+  }
+
+private:
+  static void Set(Bitset& bits, const std::size_t i) {
+    bits[i / 64] |= std::uint64_t{1} << (i % 64);
+  }
+
+  static bool Test(const Bitset& bits, const std::size_t i) {
+    return (bits[i / 64] >> (i % 64) & 1) != 0;
+  }
+
+  template <typename Func>
+  static void ForEachBit(const Bitset& bits, Func&& func) {
+    for (std::size_t k = 0; k < bits.size(); ++k) {
+      for (auto word = bits[k]; word != 0; word &= word - 1) {
+        func(k * 64 + static_cast<std::size_t>(std::countr_zero(word)));
+      }
+    }
+  }
+
+  void EnsureFresh() const {
+    if (IsStale()) {
+      Rebuild();
+    }
+  }
+
+  /*!
+   * @brief Breadth first search over non-empty paths of the snapshot
+   * @param start Dense index
+   * @param forward Whether arcs are followed forward
+   * @param func Callable on every reached dense index, true stops the search
+   * @return Whether `func` stopped the search
+   */
+  template <typename Func>
+  bool Search(const std::size_t start, const bool forward, Func&& func) const {
+    _visited.Reset(_csr.NodeSize());
+    _frontier.clear();
+    _frontier.push_back(start);
+    for (std::size_t head = 0; head < _frontier.size(); ++head) {
+      const auto v = _frontier[head];
+      for (const auto w :
+           forward ? _csr.OutNeighbors(v) : _csr.InNeighbors(v)) {
+        if (_visited.Insert(w)) {
+          if (func(w)) {
+            return true;
+          }
+          _frontier.push_back(w);
+        }
+      }
+    }
+    return false;
+  }
+
+  NodeSet Collect(const std::vector<Bitset>& closure, const bool forward,
+                  const NodePtr& n) const {
+    NodeSet res(1, utils::NodePtrHash<Node>, utils::NodePtrEqual<Node>);
+
+    const auto i = _csr.Index(n);
+    if (i != CSRGraph<Node, Edge>::npos && !_closure) {
+      Search(i, forward, [this, &res](const std::size_t w) {
+        res.insert(_csr.GetNode(w));
+        return false;
+      });
+    } else if (i != CSRGraph<Node, Edge>::npos) {
+      ForEachBit(closure[_component[i]], [this, &res](const std::size_t c) {
+        for (const auto m : _members[c]) {
+          res.insert(_csr.GetNode(m));
+        }
+      });
+    }
+
+    return res;
+  }
+
+  //! @brief Indexed graph
+  const DiGraph<Node, Edge>& _graph;
+
+  //! @brief Byte budget of the closure
+  std::size_t _max_closure_bytes;
+
+  //! @brief Whether the index has been built once
+  mutable bool _built{false};
+
+  //! @brief Whether the closure fits the budget and is built
+  mutable bool _closure{false};
+
+  //! @brief Dense snapshot the index is built on
+  mutable CSRGraph<Node, Edge> _csr;
+
+  //! @brief Component of every dense index
+  mutable std::vector<std::size_t> _component;
+
+  //! @brief Dense indices of every component
+  mutable std::vector<std::vector<std::size_t>> _members;
+
+  //! @brief Components reachable from every component
+  mutable std::vector<Bitset> _descendants;
+
+  //! @brief Components reaching every component
+  mutable std::vector<Bitset> _ancestors;
+
+  //! @brief Nodes reached by the fallback search
+  mutable utils::VisitedSet _visited;
+
+  //! @brief Queue of the fallback search
+  mutable std::vector<std::size_t> _frontier;
+};
+
+} // namespace xgraph::algorithm
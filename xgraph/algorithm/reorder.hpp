@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/type_traits.hpp"
+
+namespace xgraph::algorithm {
+
+//! @brief Vertex ordering strategy of `Reorder`
+enum class ReorderStrategy : std::uint8_t {
+  //! @brief Descending degree, hubs first
+  Degree,
+  //! @brief Reverse Cuthill-McKee, narrows the bandwidth of the adjacency
+  ReverseCuthillMcKee,
+  //! @brief Breadth first visit order
+  BFS,
+  //! @brief Rabbit Order like community clustering
+  Community,
+};
+
+/*!
+ * @brief Snapshot renumbered by `Reorder`
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node, EdgeType Edge> struct Reordering {
+  //! @brief Snapshot with the new dense indices
+  CSRGraph<Node, Edge> graph;
+
+  //! @brief New dense index of every dense index of the source snapshot
+  std::vector<std::size_t> permutation;
+};
+
+namespace detail {
+
+//! @brief Degree of every dense index, ignoring the direction of edges
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t> UndirectedDegrees(const CSRGraph<Node, Edge>& csr) {
+  std::vector<std::size_t> degree(csr.NodeSize());
+  for (std::size_t v = 0; v < degree.size(); ++v) {
+    degree[v] = csr.OutDegree(v) + csr.InDegree(v);
+  }
+  return degree;
+}
+
+//! @brief Call `func` on out and in neighbors of the node
+template <NodeType Node, EdgeType Edge, typename Func>
+void ForUndirectedNeighbors(const CSRGraph<Node, Edge>& csr,
+                            const std::size_t v, Func&& func) {
+  for (const auto u : csr.OutNeighbors(v)) {
+    func(u);
+  }
+  for (const auto u : csr.InNeighbors(v)) {
+    func(u);
+  }
+}
+
+//! @brief Indices sorted by descending degree (ties keep index order)
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t> DegreeOrder(const CSRGraph<Node, Edge>& csr) {
+  const auto degree = UndirectedDegrees(csr);
+  std::vector<std::size_t> order(csr.NodeSize());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(order, std::ranges::greater{},
+                           [&](const std::size_t v) { return degree[v]; });
+  return order;
+}
+
+/*!
+ * @brief Breadth first visit order of every component
+ * @param csr Graph snapshot
+ * @param by_degree Whether components start from a node of minimal degree
+ * and neighbors are visited by ascending degree (Cuthill-McKee)
+ * @return Indices in visit order
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t> BFSOrder(const CSRGraph<Node, Edge>& csr,
+                                  const bool by_degree) {
+  const auto n = csr.NodeSize();
+  const auto degree = UndirectedDegrees(csr);
+
+  std::vector<std::size_t> roots(n);
+  std::iota(roots.begin(), roots.end(), 0);
+  if (by_degree) {
+    std::ranges::stable_sort(roots, {},
+                             [&](const std::size_t v) { return degree[v]; });
+  }
+
+  std::vector<bool> visited(n, false);
+  std::vector<std::size_t> order;
+  order.reserve(n);
+  for (const auto root : roots) {
+    if (visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    // `order` doubles as the queue of the current component
+    auto head = order.size();
+    order.push_back(root);
+    while (head < order.size()) {
+      const auto v = order[head++];
+      const auto first = order.size();
+      ForUndirectedNeighbors(csr, v, [&](const std::size_t u) {
+        if (!visited[u]) {
+          visited[u] = true;
+          order.push_back(u);
+        }
+      });
+      if (by_degree) {
+        std::stable_sort(
+            order.begin() + static_cast<std::ptrdiff_t>(first), order.end(),
+            [&](const std::size_t lhs, const std::size_t rhs) {
+              return degree[lhs] < degree[rhs];
+            });
+      }
+    }
+  }
+  return order;
+}
+
+/*!
+ * @brief Community order by incremental aggregation (Rabbit Order)
+ *
+ * Nodes are visited by ascending degree and merged into the neighboring
+ * community with the best positive modularity gain, which builds a
+ * dendrogram. A depth first walk of the dendrogram then places every
+ * community in a contiguous range. Unlike the original algorithm, the gain
+ * is computed from the edges of the visited node only, not the aggregated
+ * edges of its community.
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t> CommunityOrder(const CSRGraph<Node, Edge>& csr) {
+  constexpr auto none = CSRGraph<Node, Edge>::npos;
+  const auto n = csr.NodeSize();
+  const auto degree = UndirectedDegrees(csr);
+  const auto total = static_cast<double>(
+      std::accumulate(degree.begin(), degree.end(), std::size_t{0}));
+
+  std::vector<std::size_t> parent(n);
+  std::iota(parent.begin(), parent.end(), 0);
+  const auto find = [&parent](std::size_t v) {
+    while (parent[v] != v) {
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+    }
+    return v;
+  };
+
+  // Dendrogram as first child / next sibling lists
+  std::vector<std::size_t> child(n, none);
+  std::vector<std::size_t> sibling(n, none);
+  std::vector<double> volume(degree.begin(), degree.end());
+
+  // Edges from the visited node to every touched community
+  std::vector<std::size_t> links(n, 0);
+  std::vector<std::size_t> touched;
+
+  std::vector<std::size_t> visit(n);
+  std::iota(visit.begin(), visit.end(), 0);
+  std::ranges::stable_sort(visit, {},
+                           [&](const std::size_t v) { return degree[v]; });
+
+  for (const auto v : visit) {
+    // Unvisited nodes are still roots, merged nodes all point below them
+    ForUndirectedNeighbors(csr, v, [&](const std::size_t u) {
+      if (const auto c = find(u); c != v && links[c]++ == 0) {
+        touched.push_back(c);
+      }
+    });
+
+    auto best = none;
+    double best_gain{0.0};
+    for (const auto c : touched) {
+      const auto gain =
+          static_cast<double>(links[c]) - volume[v] * volume[c] / total;
+      if (gain > best_gain) {
+        best = c;
+        best_gain = gain;
+      }
+      links[c] = 0;
+    }
+    touched.clear();
+
+    if (best != none) {
+      parent[v] = best;
+      volume[best] += volume[v];
+      sibling[v] = child[best];
+      child[best] = v;
+    }
+  }
+
+  std::vector<std::size_t> order;
+  order.reserve(n);
+  std::vector<std::size_t> stack;
+  for (std::size_t root = 0; root < n; ++root) {
+    if (parent[root] != root) {
+      continue;
+    }
+    stack.push_back(root);
+    while (!stack.empty()) {
+      const auto v = stack.back();
+      stack.pop_back();
+      order.push_back(v);
+      for (auto c = child[v]; c != none; c = sibling[c]) {
+        stack.push_back(c);
+      }
+    }
+  }
+  return order;
+}
+
+} // namespace detail
+
+/*!
+ * @brief Renumber the nodes of a snapshot to improve cache locality
+ *
+ * Traversals over the result touch nearby indices for nearby nodes, so
+ * per-node arrays indexed by dense index are accessed with fewer cache
+ * misses. Edge directions are ignored when ordering.
+ *
+ * @param csr Graph snapshot
+ * @param strategy Ordering strategy
+ * @return Renumbered snapshot and the permutation from the old indices
+ */
+template <NodeType Node, EdgeType Edge>
+Reordering<Node, Edge> Reorder(const CSRGraph<Node, Edge>& csr,
+                               const ReorderStrategy strategy) {
+  std::vector<std::size_t> order;
+  switch (strategy) {
+  case ReorderStrategy::Degree:
+    order = detail::DegreeOrder(csr);
+    break;
+  case ReorderStrategy::ReverseCuthillMcKee:
+    order = detail::BFSOrder(csr, true);
+    std::ranges::reverse(order);
+    break;
+  case ReorderStrategy::BFS:
+    order = detail::BFSOrder(csr, false);
+    break;
+  case ReorderStrategy::Community:
+    order = detail::CommunityOrder(csr);
+    break;
+  }
+
+  std::vector<std::size_t> permutation(order.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    permutation[order[i]] = i;
+  }
+  auto graph = csr.Permute(permutation);
+  return {std::move(graph), std::move(permutation)};
+}
+
+/*!
+ * @brief Snapshot of the graph renumbered to improve cache locality
+ * @param graph Graph
+ * @param strategy Ordering strategy
+ * @return Renumbered snapshot and the permutation from the indices of
+ * `CSRGraph(graph)` (node id order)
+ */
+template <NodeType Node, EdgeType Edge>
+Reordering<Node, Edge> Reorder(const DiGraph<Node, Edge>& graph,
+                               const ReorderStrategy strategy) {
+  return Reorder(CSRGraph<Node, Edge>(graph), strategy);
+}
+
+} // namespace xgraph::algorithm
@@ -1,23 +1,170 @@
 #pragma once
 
 #include <algorithm>
+#include <concepts>
+#include <cstdint>
 #include <format>
 #include <optional>
 #include <queue>
+#include <span>
+#include <stdexcept>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "algorithm/workspace.hpp"
+#include "structure/csr.hpp"
 #include "structure/graph.hpp"
+#include "structure/parallel.hpp"
+#include "structure/radix_heap.hpp"
 #include "structure/type_traits.hpp"
 #include "structure/utils.hpp"
 
 namespace xgraph::algorithm {
 
+/*!
+ * @brief Answer of one shortest path query of `AStarPaths`
+ * @tparam Node Node class that satisfy `NodeType` concept
+ */
+template <NodeType Node> struct PathResult {
+  //! @brief Whether the target is reachable from the source
+  bool reachable{false};
+
+  //! @brief Path from source to target (empty if unreachable)
+  std::vector<std::shared_ptr<Node>> path;
+
+  //! @brief Sum of the edge weights along the path
+  double cost{0.0};
+};
+
+namespace detail {
+
+//! @brief Maps explored nodes to parent closest to the source
+template <NodeType Node>
+using ParentMap =
+    std::unordered_map<std::shared_ptr<Node>, std::shared_ptr<Node>,
+                       NodePtrHash_t<Node>, NodePtrEqual_t<Node>>;
+
+/*!
+ * @brief Build the path from the source to an explored node
+ * @param parents Parents of explored nodes (nullptr for the source)
+ * @param node Last node of the path
+ * @return Path
+ */
+template <NodeType Node>
+std::vector<std::shared_ptr<Node>> TracePath(const ParentMap<Node>& parents,
+                                             std::shared_ptr<Node> node) {
+  std::vector<std::shared_ptr<Node>> path;
+  while (node) {
+    path.push_back(node);
+    node = parents.at(node);
+  }
+  std::ranges::reverse(path);
+  return path;
+}
+
+template <NodeType Node>
+[[noreturn]] void ThrowUnreachable(const std::shared_ptr<Node>& source,
+                                   const std::shared_ptr<Node>& target) {
+  throw std::runtime_error(std::format("Node {} not reachable from {}",
+                                       target->Name(), source->Name()));
+}
+
+/*!
+ * @brief Shortest path of unweighted graph by breadth first search
+ */
 template <NodeType Node, EdgeType Edge>
 std::vector<std::shared_ptr<Node>>
-AStarPath(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& source,
-          const std::shared_ptr<Node>& target,
-          const std::optional<Heuristic_t<Node>>& heuristic = std::nullopt) {
+BFSPath(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& source,
+        const std::shared_ptr<Node>& target) {
+  ParentMap<Node> parents{1, utils::NodePtrHash<Node>,
+                          utils::NodePtrEqual<Node>};
+  parents.emplace(source, nullptr);
+  std::queue<std::shared_ptr<Node>> queue;
+  queue.push(source);
+
+  while (!queue.empty()) {
+    const auto cur_node = queue.front();
+    queue.pop();
+
+    if (utils::NodePtrEqual(cur_node, target)) {
+      return TracePath(parents, cur_node);
+    }
+
+    for (const auto& out_edge : graph.OutEdges(cur_node->Id())) {
+      if (parents.emplace(out_edge->Target(), cur_node).second) {
+        queue.push(out_edge->Target());
+      }
+    }
+  }
+  ThrowUnreachable(source, target);
+}
+
+/*!
+ * @brief Shortest path of integer weighted graph by Dijkstra on a radix heap
+ * @throw std::invalid_argument if a negative weight is met
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::shared_ptr<Node>>
+RadixPath(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& source,
+          const std::shared_ptr<Node>& target) {
+  // (current node, parent)
+  utils::RadixHeap<std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>>>
+      queue;
+  queue.Push(0, {source, nullptr});
+
+  // Maps enqueued nodes to distance of discovered paths
+  std::unordered_map<std::shared_ptr<Node>, std::uint64_t, NodePtrHash_t<Node>,
+                     NodePtrEqual_t<Node>>
+      enqueued{1, utils::NodePtrHash<Node>, utils::NodePtrEqual<Node>};
+  enqueued.emplace(source, 0);
+  ParentMap<Node> explored{1, utils::NodePtrHash<Node>,
+                           utils::NodePtrEqual<Node>};
+
+  while (!queue.Empty()) {
+    const auto [dist, entry] = queue.Pop();
+    const auto& [cur_node, parent] = entry;
+
+    // Skip bad paths that were enqueued before finding a better one
+    if (explored.contains(cur_node) || enqueued.at(cur_node) < dist) {
+      continue;
+    }
+    explored.emplace(cur_node, parent);
+
+    if (utils::NodePtrEqual(cur_node, target)) {
+      return TracePath(explored, cur_node);
+    }
+
+    for (const auto& out_edge : graph.OutEdges(cur_node->Id())) {
+      const auto cost = out_edge->Weight();
+      if constexpr (std::is_signed_v<decltype(cost)>) {
+        if (cost < 0) {
+          throw std::invalid_argument("Negative edge weight");
+        }
+      }
+
+      const auto new_cost = dist + static_cast<std::uint64_t>(cost);
+      const auto& neighbor = out_edge->Target();
+      if (const auto it = enqueued.find(neighbor);
+          it != enqueued.end() && it->second <= new_cost) {
+        continue;
+      }
+      enqueued[neighbor] = new_cost;
+      queue.Push(new_cost, {neighbor, cur_node});
+    }
+  }
+  ThrowUnreachable(source, target);
+}
+
+/*!
+ * @brief Shortest path by A* on a binary heap
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::shared_ptr<Node>>
+HeapAStarPath(const DiGraph<Node, Edge>& graph,
+              const std::shared_ptr<Node>& source,
+              const std::shared_ptr<Node>& target,
+              const std::optional<Heuristic_t<Node>>& heuristic) {
   // Type definition
   using ElemType = std::tuple<double,                // priority
                               std::shared_ptr<Node>, // current node
@@ -39,9 +186,8 @@ AStarPath(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& source,
                      NodePtrHash_t<Node>, NodePtrEqual_t<Node>>
       enqueued{1, utils::NodePtrHash<Node>, utils::NodePtrEqual<Node>};
   // Maps explored nodes to parent closet to the source
-  std::unordered_map<std::shared_ptr<Node>, std::shared_ptr<Node>,
-                     NodePtrHash_t<Node>, NodePtrEqual_t<Node>>
-      explored{1, utils::NodePtrHash<Node>, utils::NodePtrEqual<Node>};
+  ParentMap<Node> explored{1, utils::NodePtrHash<Node>,
+                           utils::NodePtrEqual<Node>};
 
   while (!queue.empty()) {
     const auto [_, cur_node, dist, parent] = queue.top();
@@ -73,7 +219,7 @@ AStarPath(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& source,
     explored[cur_node] = parent;
 
     for (const auto& out_edge : graph.OutEdges(cur_node->Id())) {
-      const auto& cost = out_edge->Weight();
+      const auto cost = static_cast<double>(out_edge->Weight());
       const auto new_cost = dist + cost;
       const auto& neighbor = out_edge->Target();
       double h{0.0};
@@ -91,8 +237,120 @@ AStarPath(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& source,
       queue.emplace(new_cost + h, neighbor, new_cost, cur_node);
     }
   }
-  throw std::runtime_error(std::format("Node {} not reachable from {}",
-                                       target->Name(), source->Name()));
+  ThrowUnreachable(source, target);
+}
+
+/*!
+ * @brief Shortest path by A* over a snapshot
+ * @param csr Graph snapshot
+ * @param source Dense index of source
+ * @param target Dense index of target
+ * @param estimate Admissible estimation of the cost to target, callable on
+ * (dense index, dense index of target)
+ * @param ws Workspace
+ * @param res Path and cost, unreachable targets are flagged
+ */
+template <NodeType Node, EdgeType Edge, typename Estimate>
+void CSRAStarPath(const CSRGraph<Node, Edge>& csr, const std::size_t source,
+                  const std::size_t target, Estimate& estimate, Workspace& ws,
+                  PathResult<Node>& res) {
+  constexpr auto none = CSRGraph<Node, Edge>::npos;
+  const auto greater = [](const auto& lhs, const auto& rhs) {
+    return lhs.first > rhs.first;
+  };
+  const auto reach = [&](const std::size_t v) {
+    ws.reached.Insert(v);
+    ws.estimate[v] = estimate(v, target);
+  };
+
+  res.reachable = false;
+  res.path.clear();
+  res.cost = 0.0;
+  if (source == none || target == none) {
+    return;
+  }
+
+  ws.Reset(csr.NodeSize());
+  reach(source);
+  ws.dist[source] = 0.0;
+  ws.parent[source] = none;
+  ws.heap.emplace_back(ws.estimate[source], source);
+
+  while (!ws.heap.empty()) {
+    std::ranges::pop_heap(ws.heap, greater);
+    const auto [priority, v] = ws.heap.back();
+    ws.heap.pop_back();
+
+    // Skip bad paths that were enqueued before finding a better one
+    if (priority > ws.dist[v] + ws.estimate[v]) {
+      continue;
+    }
+
+    if (v == target) {
+      res.reachable = true;
+      res.cost = ws.dist[v];
+      for (auto n = v; n != none; n = ws.parent[n]) {
+        res.path.push_back(csr.GetNode(n));
+      }
+      std::ranges::reverse(res.path);
+      return;
+    }
+
+    const auto neighbors = csr.OutNeighbors(v);
+    for (std::size_t k = 0; k < neighbors.size(); ++k) {
+      const auto w = neighbors[k];
+      double cost{1.0};
+      if constexpr (!IsUnweighted_v<Edge>) {
+        cost = static_cast<double>(csr.OutWeights(v)[k]);
+      }
+
+      const auto new_cost = ws.dist[v] + cost;
+      if (!ws.reached.Contains(w)) {
+        reach(w);
+      } else if (ws.dist[w] <= new_cost) {
+        continue;
+      }
+      ws.dist[w] = new_cost;
+      ws.parent[w] = v;
+      ws.heap.emplace_back(new_cost + ws.estimate[w], w);
+      std::ranges::push_heap(ws.heap, greater);
+    }
+  }
+}
+
+} // namespace detail
+
+/*!
+ * @brief Shortest path from source to target
+ *
+ * The engine is chosen by the edge weight type: breadth first search for
+ * unweighted edges, Dijkstra on a radix heap for integer weights without
+ * heuristic, A* on a binary heap otherwise.
+ *
+ * @param graph Graph
+ * @param source Source node
+ * @param target Target node
+ * @param heuristic Admissible estimation of the cost to target (unused for
+ * unweighted edges)
+ * @return Path from source to target
+ * @throw std::runtime_error if target is not reachable
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::shared_ptr<Node>>
+AStarPath(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& source,
+          const std::shared_ptr<Node>& target,
+          [[maybe_unused]] const std::optional<Heuristic_t<Node>>& heuristic =
+              std::nullopt) {
+  if constexpr (IsUnweighted_v<Edge>) {
+    return detail::BFSPath(graph, source, target);
+  } else {
+    if constexpr (std::integral<EdgeWeight_t<Edge>>) {
+      if (!heuristic.has_value()) {
+        return detail::RadixPath(graph, source, target);
+      }
+    }
+    return detail::HeapAStarPath(graph, source, target, heuristic);
+  }
 }
 
 template <NodeType Node, EdgeType Edge>
@@ -103,4 +361,93 @@ AStarPath(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& source,
   return AStarPath(DiGraph<Node, Edge>(graph), source, target, heuristic);
 }
 
+/*!
+ * @brief Shortest path over a snapshot with a reusable workspace
+ *
+ * Runs A* like `AStarPaths` for one query. Once the workspace and the path
+ * buffer of `res` are warm, repeated queries do not allocate.
+ *
+ * @param csr Graph snapshot
+ * @param source Source node
+ * @param target Target node
+ * @param ws Workspace
+ * @param res Path and cost, nodes that are not in the snapshot are
+ * unreachable
+ * @param heuristic Admissible estimation of the cost to target
+ */
+template <NodeType Node, EdgeType Edge>
+void AStarPath(const CSRGraph<Node, Edge>& csr,
+               const std::shared_ptr<Node>& source,
+               const std::shared_ptr<Node>& target, Workspace& ws,
+               PathResult<Node>& res,
+               const std::optional<Heuristic_t<Node>>& heuristic =
+                   std::nullopt) {
+  const auto estimate = [&](const std::size_t v, const std::size_t t) {
+    return heuristic.has_value()
+               ? heuristic.value()(csr.GetNode(v), csr.GetNode(t))
+               : 0.0;
+  };
+  detail::CSRAStarPath(csr, csr.Index(source), csr.Index(target), estimate,
+                       ws, res);
+}
+
+/*!
+ * @brief Shortest paths of many queries in parallel
+ *
+ * Queries are spread over worker threads, each with its own reusable
+ * workspace, and run A* on the snapshot without locking.
+ *
+ * @param csr Graph snapshot
+ * @param queries (source, target) pairs
+ * @param heuristic Admissible estimation of the cost to target, called
+ * concurrently
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Result of every query in input order, nodes that are not in the
+ * snapshot are unreachable
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<PathResult<Node>> AStarPaths(
+    const CSRGraph<Node, Edge>& csr,
+    std::type_identity_t<std::span<const PathQuery_t<Node>>> queries,
+    const std::optional<Heuristic_t<Node>>& heuristic = std::nullopt,
+    const std::size_t threads = 0) {
+  std::vector<PathResult<Node>> res(queries.size());
+  std::vector<Workspace> workspaces(utils::WorkerCount(threads));
+  const auto estimate = [&](const std::size_t v, const std::size_t t) {
+    return heuristic.has_value()
+               ? heuristic.value()(csr.GetNode(v), csr.GetNode(t))
+               : 0.0;
+  };
+  utils::ParallelFor(
+      queries.size(), threads,
+      [&](const std::size_t worker, const std::size_t i) {
+        const auto& [source, target] = queries[i];
+        detail::CSRAStarPath(csr, csr.Index(source), csr.Index(target),
+                             estimate, workspaces[worker], res[i]);
+      });
+  return res;
+}
+
+/*!
+ * @brief Shortest paths of many queries in parallel on a snapshot of the
+ * graph
+ * @note Every call builds a `CSRGraph` of the whole graph first, which costs
+ * O(nodes + edges). Callers issuing several batches on an unchanged graph
+ * should build the snapshot once and call the `CSRGraph` overload.
+ * @param graph Graph, must not change during the call
+ * @param queries (source, target) pairs
+ * @param heuristic Admissible estimation of the cost to target, called
+ * concurrently
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Result of every query in input order
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<PathResult<Node>> AStarPaths(
+    const DiGraph<Node, Edge>& graph,
+    std::type_identity_t<std::span<const PathQuery_t<Node>>> queries,
+    const std::optional<Heuristic_t<Node>>& heuristic = std::nullopt,
+    const std::size_t threads = 0) {
+  return AStarPaths(CSRGraph<Node, Edge>(graph), queries, heuristic, threads);
+}
+
 } // namespace xgraph::algorithm
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/parallel.hpp"
+#include "structure/type_traits.hpp"
+#include "structure/union_find.hpp"
+
+namespace xgraph::algorithm {
+
+/*!
+ * @brief Minimum spanning forest
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <EdgeType Edge> struct SpanningForest {
+  //! @brief Edges of the forest by increasing weight
+  std::vector<std::shared_ptr<Edge>> edges;
+
+  //! @brief Arc position of every edge in the snapshot (see `EdgeColumn`)
+  std::vector<std::size_t> arcs;
+
+  //! @brief Sum of the edge weights
+  double weight{0.0};
+};
+
+namespace detail {
+
+//! @brief Candidate edge of a spanning forest
+struct ForestEdge {
+  double weight;
+  std::size_t source;
+  std::size_t target;
+  //! @brief Arc position, also breaks ties between equal weights
+  std::size_t arc;
+
+  friend bool operator<(const ForestEdge& lhs, const ForestEdge& rhs) {
+    return lhs.weight != rhs.weight ? lhs.weight < rhs.weight
+                                    : lhs.arc < rhs.arc;
+  }
+};
+
+//! @brief Size of edges handed to a worker at once
+inline constexpr std::size_t FOREST_BLOCK = 4096;
+
+//! @brief Size of edges below which filter-Kruskal just sorts
+inline constexpr std::size_t KRUSKAL_CUTOFF = 256;
+
+/*!
+ * @brief Candidate edges of a snapshot, seen as undirected
+ *
+ * Self loops are dropped, and so is the reverse arc of every undirected
+ * edge. Ties are broken by arc position, so the minimum forest is unique.
+ *
+ * @param csr Graph snapshot
+ * @return Edges
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<ForestEdge> CollectForestEdges(const CSRGraph<Node, Edge>& csr) {
+  std::vector<ForestEdge> res;
+  res.reserve(csr.IsDirected() ? csr.EdgeSize() : csr.EdgeSize() / 2);
+  for (std::size_t s = 0; s < csr.NodeSize(); ++s) {
+    const auto row = csr.OutNeighbors(s);
+    for (std::size_t k = 0; k < row.size(); ++k) {
+      const auto t = row[k];
+      if (t == s || (!csr.IsDirected() && t < s)) {
+        continue;
+      }
+      double weight{1.0};
+      if constexpr (!IsUnweighted_v<Edge>) {
+        weight = static_cast<double>(csr.OutWeights(s)[k]);
+      }
+      res.push_back({weight, s, t, csr.OutOffset(s) + k});
+    }
+  }
+  return res;
+}
+
+/*!
+ * @brief Fill the result from the chosen edges
+ * @param csr Graph snapshot
+ * @param chosen Edges of the forest by increasing weight
+ * @return Forest
+ */
+template <NodeType Node, EdgeType Edge>
+SpanningForest<Edge> MakeForest(const CSRGraph<Node, Edge>& csr,
+                                const std::vector<ForestEdge>& chosen) {
+  SpanningForest<Edge> res;
+  res.edges.reserve(chosen.size());
+  res.arcs.reserve(chosen.size());
+  for (const auto& e : chosen) {
+    const auto row = csr.OutEdges(e.source);
+    res.edges.push_back(row[e.arc - csr.OutOffset(e.source)]);
+    res.arcs.push_back(e.arc);
+    res.weight += e.weight;
+  }
+  return res;
+}
+
+/*!
+ * @brief Filter-Kruskal over a range of candidate edges
+ *
+ * Edges are partitioned around a pivot. The light half is solved first,
+ * then heavy edges inside one tree are filtered out before solving the
+ * heavy half, so most of them are never sorted.
+ *
+ * @param edges Candidate edges, reordered
+ * @param sets Trees built so far
+ * @param chosen Edges of the forest, appended by increasing weight
+ */
+inline void FilterKruskal(std::span<ForestEdge> edges,
+                          utils::ConcurrentUnionFind& sets,
+                          std::vector<ForestEdge>& chosen) {
+  if (edges.size() <= KRUSKAL_CUTOFF) {
+    std::ranges::sort(edges, std::less{});
+    for (const auto& e : edges) {
+      if (sets.Unite(e.source, e.target)) {
+        chosen.push_back(e);
+      }
+    }
+    return;
+  }
+
+  // Median of three, never the largest since edges are distinct
+  auto a = edges.front();
+  auto b = edges[edges.size() / 2];
+  auto c = edges.back();
+  if (b < a) {
+    std::swap(a, b);
+  }
+  if (c < b) {
+    b = c < a ? a : c;
+  }
+  const auto pivot = b;
+
+  const auto heavy = std::ranges::partition(
+      edges, [&pivot](const ForestEdge& e) { return !(pivot < e); });
+  const auto light_size =
+      static_cast<std::size_t>(heavy.begin() - edges.begin());
+  FilterKruskal(edges.first(light_size), sets, chosen);
+
+  const auto rest = edges.subspan(light_size);
+  const auto dropped = std::ranges::partition(
+      rest, [&sets](const ForestEdge& e) {
+        return !sets.Same(e.source, e.target);
+      });
+  FilterKruskal(
+      rest.first(static_cast<std::size_t>(dropped.begin() - rest.begin())),
+      sets, chosen);
+}
+
+} // namespace detail
+
+/*!
+ * @brief Minimum spanning forest by parallel Boruvka
+ *
+ * Every round, each tree picks its lightest outgoing edge with a lock-free
+ * minimum per root, then the picked edges are merged into a concurrent
+ * union-find and edges inside one tree are dropped. Edges are scanned in
+ * parallel blocks. Directed graphs are seen as undirected.
+ *
+ * @param csr Graph snapshot
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Forest, same as `FilterKruskalForest`
+ */
+template <NodeType Node, EdgeType Edge>
+SpanningForest<Edge> MinimumSpanningForest(const CSRGraph<Node, Edge>& csr,
+                                           const std::size_t threads = 0) {
+  constexpr auto npos = CSRGraph<Node, Edge>::npos;
+  const auto n = csr.NodeSize();
+  auto edges = detail::CollectForestEdges(csr);
+  utils::ConcurrentUnionFind sets(n);
+  std::vector<std::atomic<std::size_t>> lightest(n);
+  for (auto& l : lightest) {
+    l.store(npos, std::memory_order_relaxed);
+  }
+  std::vector<std::uint8_t> state(edges.size());
+  std::vector<detail::ForestEdge> chosen;
+
+  const auto blocks = [](const std::size_t size) {
+    return (size + detail::FOREST_BLOCK - 1) / detail::FOREST_BLOCK;
+  };
+  const auto block = [](const std::size_t b, const std::size_t size) {
+    return std::pair{b * detail::FOREST_BLOCK,
+                     std::min(size, (b + 1) * detail::FOREST_BLOCK)};
+  };
+
+  // States of edges in a round
+  constexpr std::uint8_t LIVE = 0;
+  constexpr std::uint8_t INSIDE = 1;
+  constexpr std::uint8_t PICKED = 2;
+  while (!edges.empty()) {
+    // Lightest edge leaving every tree
+    utils::ParallelFor(
+        blocks(edges.size()), threads, [&](std::size_t, const std::size_t b) {
+          const auto [first, last] = block(b, edges.size());
+          for (auto i = first; i < last; ++i) {
+            const auto s = sets.Find(edges[i].source);
+            const auto t = sets.Find(edges[i].target);
+            if (s == t) {
+              state[i] = INSIDE;
+              continue;
+            }
+            state[i] = LIVE;
+            for (const auto root : {s, t}) {
+              auto current = lightest[root].load(std::memory_order_relaxed);
+              while ((current == npos || edges[i] < edges[current]) &&
+                     !lightest[root].compare_exchange_weak(
+                         current, i, std::memory_order_relaxed)) {
+              }
+            }
+          }
+        });
+
+    // Merge, an edge picked by both of its trees unites them once
+    utils::ParallelFor(
+        blocks(n), threads, [&](std::size_t, const std::size_t b) {
+          const auto [first, last] = block(b, n);
+          for (auto v = first; v < last; ++v) {
+            const auto i = lightest[v].load(std::memory_order_relaxed);
+            if (i == npos) {
+              continue;
+            }
+            lightest[v].store(npos, std::memory_order_relaxed);
+            if (sets.Unite(edges[i].source, edges[i].target)) {
+              state[i] = PICKED;
+            }
+          }
+        });
+
+    std::size_t kept{0};
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+      if (state[i] == PICKED) {
+        chosen.push_back(edges[i]);
+      } else if (state[i] == LIVE) {
+        edges[kept++] = edges[i];
+      }
+    }
+    edges.resize(kept);
+  }
+
+  std::ranges::sort(chosen, std::less{});
+  return detail::MakeForest(csr, chosen);
+}
+
+/*!
+ * @brief Minimum spanning forest by parallel Boruvka
+ * @param graph Graph
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Forest
+ */
+template <NodeType Node, EdgeType Edge>
+SpanningForest<Edge> MinimumSpanningForest(const DiGraph<Node, Edge>& graph,
+                                           const std::size_t threads = 0) {
+  return MinimumSpanningForest(CSRGraph<Node, Edge>(graph), threads);
+}
+
+/*!
+ * @brief Minimum spanning forest by filter-Kruskal
+ *
+ * Sequential, and faster than sorting all edges on sparse graphs where most
+ * heavy edges close cycles. Directed graphs are seen as undirected.
+ *
+ * @param csr Graph snapshot
+ * @return Forest, same as `MinimumSpanningForest`
+ */
+template <NodeType Node, EdgeType Edge>
+SpanningForest<Edge> FilterKruskalForest(const CSRGraph<Node, Edge>& csr) {
+  auto edges = detail::CollectForestEdges(csr);
+  utils::ConcurrentUnionFind sets(csr.NodeSize());
+  std::vector<detail::ForestEdge> chosen;
+  detail::FilterKruskal(edges, sets, chosen);
+  return detail::MakeForest(csr, chosen);
+}
+
+/*!
+ * @brief Minimum spanning forest by filter-Kruskal
+ * @param graph Graph
+ * @return Forest
+ */
+template <NodeType Node, EdgeType Edge>
+SpanningForest<Edge> FilterKruskalForest(const DiGraph<Node, Edge>& graph) {
+  return FilterKruskalForest(CSRGraph<Node, Edge>(graph));
+}
+
+} // namespace xgraph::algorithm
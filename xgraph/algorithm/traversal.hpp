@@ -3,33 +3,151 @@
 #include <optional>
 #include <queue>
 #include <stack>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "algorithm/workspace.hpp"
+#include "structure/compressed_graph.hpp"
+#include "structure/csr.hpp"
 #include "structure/graph.hpp"
 #include "structure/type_traits.hpp"
+#include "structure/visited_set.hpp"
 
 namespace xgraph::algorithm {
 
+/*!
+ * @brief Breadth first search
+ * @param graph Graph
+ * @param start Start node, nothing is visited if it is not in the graph
+ * @param visited Visited set keyed by node slot, reused between calls
+ * @param func Visitor
+ */
 template <NodeType Node, EdgeType Edge>
 void BFS(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         utils::VisitedSet& visited,
          const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  const auto slot = graph.Slot(start->Id());
+  if (slot == DiGraph<Node, Edge>::npos) {
+    return;
+  }
   std::queue<std::shared_ptr<Node>> q;
-  std::unordered_map<std::size_t, bool> visited;
+  visited.Reset(graph.SlotSize());
+  visited.Insert(slot);
+  q.push(start);
+
+  while (!q.empty()) {
+    const auto n = q.front();
+    q.pop();
+
+    if (func.has_value()) {
+      func.value()(n);
+    }
 
-  if (func.has_value()) {
-    func.value()(start);
+    for (const auto& i : graph.Neighbors(n->Id())) {
+      if (visited.Insert(graph.Slot(i->Id()))) {
+        q.push(i);
+      }
+    }
   }
-  visited[start->Id()] = true;
+}
 
-  for (const auto& i : graph.Neighbors(start->Name())) {
-    q.push(i);
-    visited.try_emplace(i->Id(), false);
+template <NodeType Node, EdgeType Edge>
+void BFS(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  utils::VisitedSet visited;
+  BFS(graph, start, visited, func);
+}
+
+template <NodeType Node, EdgeType Edge>
+void BFS(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         utils::VisitedSet& visited,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  BFS(static_cast<const DiGraph<Node, Edge>&>(graph), start, visited, func);
+}
+
+template <NodeType Node, EdgeType Edge>
+void BFS(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  BFS(static_cast<const DiGraph<Node, Edge>&>(graph), start, func);
+}
+
+/*!
+ * @brief Breadth first search decoding the compressed lists on the fly
+ * @param graph Compressed graph
+ * @param start Start node, nothing is visited if it is not in the graph
+ * @param visited Visited set keyed by dense index, reused between calls
+ * @param func Visitor
+ */
+template <NodeType Node, EdgeType Edge>
+void BFS(const CompressedGraph<Node, Edge>& graph,
+         const std::shared_ptr<Node>& start, utils::VisitedSet& visited,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  const auto s = graph.Index(start);
+  if (s == CompressedGraph<Node, Edge>::npos) {
+    return;
   }
+  std::queue<std::size_t> q;
+  visited.Reset(graph.NodeSize());
+  visited.Insert(s);
+  q.push(s);
 
   while (!q.empty()) {
     const auto n = q.front();
     q.pop();
 
-    if (visited[n->Id()]) {
+    if (func.has_value()) {
+      func.value()(graph.GetNode(n));
+    }
+
+    // Parents and children like `DiGraph::Neighbors`
+    for (const auto i : graph.OutNeighbors(n)) {
+      if (visited.Insert(i)) {
+        q.push(i);
+      }
+    }
+    if (graph.IsDirected()) {
+      for (const auto i : graph.InNeighbors(n)) {
+        if (visited.Insert(i)) {
+          q.push(i);
+        }
+      }
+    }
+  }
+}
+
+template <NodeType Node, EdgeType Edge>
+void BFS(const CompressedGraph<Node, Edge>& graph,
+         const std::shared_ptr<Node>& start,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  utils::VisitedSet visited;
+  BFS(graph, start, visited, func);
+}
+
+/*!
+ * @brief Depth first search
+ * @param graph Graph
+ * @param start Start node, nothing is visited if it is not in the graph
+ * @param visited Visited set keyed by node slot, reused between calls
+ * @param func Visitor
+ */
+template <NodeType Node, EdgeType Edge>
+void DFS(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         utils::VisitedSet& visited,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  if (graph.Slot(start->Id()) == DiGraph<Node, Edge>::npos) {
+    return;
+  }
+  std::stack<std::shared_ptr<Node>> s;
+  visited.Reset(graph.SlotSize());
+  s.push(start);
+
+  while (!s.empty()) {
+    const auto n = s.top();
+    s.pop();
+
+    if (!visited.Insert(graph.Slot(n->Id()))) {
       continue;
     }
 
@@ -37,62 +155,185 @@ void BFS(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
       func.value()(n);
     }
 
-    visited[n->Id()] = true;
-
-    for (const auto& i : graph.Neighbors(n->Name())) {
-      q.push(i);
-      visited.try_emplace(i->Id(), false);
+    for (const auto& i : graph.Neighbors(n->Id())) {
+      if (!visited.Contains(graph.Slot(i->Id()))) {
+        s.push(i);
+      }
     }
   }
 }
 
 template <NodeType Node, EdgeType Edge>
-void BFS(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+void DFS(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
          const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
-  BFS(DiGraph<Node, Edge>(graph), start, func);
+  utils::VisitedSet visited;
+  DFS(graph, start, visited, func);
 }
 
 template <NodeType Node, EdgeType Edge>
-void DFS(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+void DFS(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         utils::VisitedSet& visited,
          const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
-  std::stack<std::shared_ptr<Node>> s;
-  std::unordered_map<std::size_t, bool> visited;
+  DFS(static_cast<const DiGraph<Node, Edge>&>(graph), start, visited, func);
+}
 
-  if (func.has_value()) {
-    func.value()(start);
-  }
-  visited[start->Id()] = true;
+template <NodeType Node, EdgeType Edge>
+void DFS(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  DFS(static_cast<const DiGraph<Node, Edge>&>(graph), start, func);
+}
 
-  for (const auto& i : graph.Neighbors(start->Name())) {
-    s.push(i);
-    visited.try_emplace(i->Id(), false);
+/*!
+ * @brief Depth first search decoding the compressed lists on the fly
+ * @param graph Compressed graph
+ * @param start Start node, nothing is visited if it is not in the graph
+ * @param visited Visited set keyed by dense index, reused between calls
+ * @param func Visitor
+ */
+template <NodeType Node, EdgeType Edge>
+void DFS(const CompressedGraph<Node, Edge>& graph,
+         const std::shared_ptr<Node>& start, utils::VisitedSet& visited,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  const auto index = graph.Index(start);
+  if (index == CompressedGraph<Node, Edge>::npos) {
+    return;
   }
+  std::stack<std::size_t> s;
+  visited.Reset(graph.NodeSize());
+  s.push(index);
 
   while (!s.empty()) {
     const auto n = s.top();
     s.pop();
 
-    if (visited[n->Id()]) {
+    if (!visited.Insert(n)) {
       continue;
     }
 
     if (func.has_value()) {
-      func.value()(n);
+      func.value()(graph.GetNode(n));
+    }
+
+    // Parents and children like `DiGraph::Neighbors`
+    for (const auto i : graph.OutNeighbors(n)) {
+      if (!visited.Contains(i)) {
+        s.push(i);
+      }
+    }
+    if (graph.IsDirected()) {
+      for (const auto i : graph.InNeighbors(n)) {
+        if (!visited.Contains(i)) {
+          s.push(i);
+        }
+      }
+    }
+  }
+}
+
+template <NodeType Node, EdgeType Edge>
+void DFS(const CompressedGraph<Node, Edge>& graph,
+         const std::shared_ptr<Node>& start,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  utils::VisitedSet visited;
+  DFS(graph, start, visited, func);
+}
+
+/*!
+ * @brief Breadth first search over a snapshot with a reusable workspace
+ *
+ * Out and in arcs are followed like `DiGraph::Neighbors`. Once the workspace
+ * is warm, repeated searches do not allocate.
+ *
+ * @param csr Graph snapshot
+ * @param start Start node, nothing is visited if it is not in the snapshot
+ * @param ws Workspace
+ * @param func Visitor
+ */
+template <NodeType Node, EdgeType Edge>
+void BFS(const CSRGraph<Node, Edge>& csr, const std::shared_ptr<Node>& start,
+         Workspace& ws,
+         const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  const auto s = csr.Index(start);
+  if (s == CSRGraph<Node, Edge>::npos) {
+    return;
+  }
+  ws.Reset(csr.NodeSize());
+  ws.reached.Insert(s);
+  ws.frontier.push_back(s);
+
+  const auto visit = [&ws](const std::size_t i) {
+    if (ws.reached.Insert(i)) {
+      ws.frontier.push_back(i);
     }
+  };
+  // `frontier` is the queue, every node enters it once
+  for (std::size_t head = 0; head < ws.frontier.size(); ++head) {
+    const auto n = ws.frontier[head];
 
-    visited[n->Id()] = true;
+    if (func.has_value()) {
+      func.value()(csr.GetNode(n));
+    }
 
-    for (const auto& i : graph.Neighbors(n->Name())) {
-      s.push(i);
-      visited.try_emplace(i->Id(), false);
+    for (const auto i : csr.OutNeighbors(n)) {
+      visit(i);
+    }
+    if (csr.IsDirected()) {
+      for (const auto i : csr.InNeighbors(n)) {
+        visit(i);
+      }
     }
   }
 }
 
+/*!
+ * @brief Depth first search over a snapshot with a reusable workspace
+ *
+ * Out and in arcs are followed like `DiGraph::Neighbors`. Once the workspace
+ * is warm, repeated searches do not allocate.
+ *
+ * @param csr Graph snapshot
+ * @param start Start node, nothing is visited if it is not in the snapshot
+ * @param ws Workspace
+ * @param func Visitor
+ */
 template <NodeType Node, EdgeType Edge>
-void DFS(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+void DFS(const CSRGraph<Node, Edge>& csr, const std::shared_ptr<Node>& start,
+         Workspace& ws,
          const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
-  DFS(DiGraph<Node, Edge>(graph), start, func);
+  const auto s = csr.Index(start);
+  if (s == CSRGraph<Node, Edge>::npos) {
+    return;
+  }
+  ws.Reset(csr.NodeSize());
+  ws.frontier.push_back(s);
+
+  const auto visit = [&ws](const std::size_t i) {
+    if (!ws.reached.Contains(i)) {
+      ws.frontier.push_back(i);
+    }
+  };
+  // `frontier` is the stack
+  while (!ws.frontier.empty()) {
+    const auto n = ws.frontier.back();
+    ws.frontier.pop_back();
+
+    if (!ws.reached.Insert(n)) {
+      continue;
+    }
+
+    if (func.has_value()) {
+      func.value()(csr.GetNode(n));
+    }
+
+    for (const auto i : csr.OutNeighbors(n)) {
+      visit(i);
+    }
+    if (csr.IsDirected()) {
+      for (const auto i : csr.InNeighbors(n)) {
+        visit(i);
+      }
+    }
+  }
 }
 
 template <NodeType Node, EdgeType Edge>
@@ -137,4 +378,265 @@ void TopologicalSort(
   }
 }
 
+/*!
+ * @brief Topological sort of a snapshot with a reusable workspace
+ *
+ * Nodes are visited by generations of zero in degree nodes like
+ * `TopologicalSort` of a `DiGraph`. Once the workspace is warm, repeated
+ * sorts do not allocate.
+ *
+ * @param csr Graph snapshot
+ * @param ws Workspace
+ * @param func Visitor
+ * @throw std::runtime_error if the graph contains a cycle
+ */
+template <NodeType Node, EdgeType Edge>
+void TopologicalSort(
+    const CSRGraph<Node, Edge>& csr, Workspace& ws,
+    const std::optional<NodePtrVisitor_t<Node>>& func = std::nullopt) {
+  const auto n = csr.NodeSize();
+  ws.Reset(n);
+  for (std::size_t v = 0; v < n; ++v) {
+    ws.indegree[v] = csr.InDegree(v);
+    if (ws.indegree[v] == 0) {
+      ws.frontier.push_back(v);
+    }
+  }
+
+  // A queue keeps generations in order
+  for (std::size_t head = 0; head < ws.frontier.size(); ++head) {
+    const auto v = ws.frontier[head];
+
+    if (func.has_value()) {
+      func.value()(csr.GetNode(v));
+    }
+
+    for (const auto child : csr.OutNeighbors(v)) {
+      if (--ws.indegree[child] == 0) {
+        ws.frontier.push_back(child);
+      }
+    }
+  }
+  if (ws.frontier.size() != n) {
+    throw std::runtime_error("Graph contains a cycle!");
+  }
+}
+
+namespace detail {
+
+/*!
+ * @brief Call `func(neighbor, edge)` for every edge of the node in both
+ * directions, like `DiGraph::Neighbors`
+ */
+template <NodeType Node, EdgeType Edge, typename Func>
+void ForEachNeighbor(const DiGraph<Node, Edge>& graph,
+                     const std::shared_ptr<Node>& n, Func&& func) {
+  const auto other = [&n](const std::shared_ptr<Edge>& e) {
+    auto target = e->Target();
+    return target->Id() == n->Id() ? e->Source() : target;
+  };
+  for (const auto& e : graph.OutEdges(n->Id())) {
+    func(other(e), e);
+  }
+  // In edges of undirected graphs are the out edges
+  if (graph.IsDirected()) {
+    for (const auto& e : graph.InEdges(n->Id())) {
+      func(other(e), e);
+    }
+  }
+}
+
+//! @brief Run a hook, `void` hooks always continue
+template <typename Func> VisitControl Control(Func&& func) {
+  if constexpr (std::is_void_v<std::invoke_result_t<Func>>) {
+    func();
+    return VisitControl::Continue;
+  } else {
+    return func();
+  }
+}
+
+template <typename Visitor, NodeType Node>
+VisitControl DiscoverNode(Visitor& visitor, const std::shared_ptr<Node>& n) {
+  if constexpr (requires { visitor.DiscoverNode(n); }) {
+    return Control([&] { return visitor.DiscoverNode(n); });
+  } else if constexpr (std::invocable<Visitor&,
+                                      const std::shared_ptr<Node>&>) {
+    return visitor(n);
+  } else {
+    return VisitControl::Continue;
+  }
+}
+
+template <typename Visitor, EdgeType Edge>
+VisitControl ExamineEdge(Visitor& visitor, const std::shared_ptr<Edge>& e) {
+  if constexpr (requires { visitor.ExamineEdge(e); }) {
+    return Control([&] { return visitor.ExamineEdge(e); });
+  } else {
+    return VisitControl::Continue;
+  }
+}
+
+template <typename Visitor, NodeType Node>
+VisitControl FinishNode(Visitor& visitor, const std::shared_ptr<Node>& n) {
+  if constexpr (requires { visitor.FinishNode(n); }) {
+    return Control([&] { return visitor.FinishNode(n); });
+  } else {
+    return VisitControl::Continue;
+  }
+}
+
+} // namespace detail
+
+/*!
+ * @brief Breadth first search driven by a visitor
+ *
+ * `DiscoverNode` is called when a node is visited, `SkipChildren` leaves it
+ * unexpanded. `ExamineEdge` is called for every edge of an expanded node,
+ * `SkipChildren` does not follow it. `FinishNode` is called once the node is
+ * expanded. Any hook may return `Stop`. Missing hooks cost nothing.
+ *
+ * @param graph Graph
+ * @param start Start node, nothing is visited if it is not in the graph
+ * @param visitor Visitor
+ * @return Whether the visitor stopped the traversal
+ */
+template <NodeType Node, EdgeType Edge, TraversalVisitor<Node, Edge> Visitor>
+bool BFS(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         Visitor&& visitor) {
+  const auto slot = graph.Slot(start->Id());
+  if (slot == DiGraph<Node, Edge>::npos) {
+    return false;
+  }
+  utils::VisitedSet visited;
+  visited.Reset(graph.SlotSize());
+  visited.Insert(slot);
+  std::queue<std::shared_ptr<Node>> q;
+  q.push(start);
+
+  while (!q.empty()) {
+    const auto n = q.front();
+    q.pop();
+
+    const auto control = detail::DiscoverNode(visitor, n);
+    if (control == VisitControl::Stop) {
+      return true;
+    }
+
+    if (control != VisitControl::SkipChildren) {
+      bool stop{false};
+      detail::ForEachNeighbor(
+          graph, n,
+          [&](const std::shared_ptr<Node>& i, const std::shared_ptr<Edge>& e) {
+            if (stop) {
+              return;
+            }
+            if (const auto c = detail::ExamineEdge(visitor, e);
+                c != VisitControl::Continue) {
+              stop = c == VisitControl::Stop;
+              return;
+            }
+            if (visited.Insert(graph.Slot(i->Id()))) {
+              q.push(i);
+            }
+          });
+      if (stop) {
+        return true;
+      }
+    }
+
+    if (detail::FinishNode(visitor, n) == VisitControl::Stop) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <NodeType Node, EdgeType Edge, TraversalVisitor<Node, Edge> Visitor>
+bool BFS(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         Visitor&& visitor) {
+  return BFS(static_cast<const DiGraph<Node, Edge>&>(graph), start, visitor);
+}
+
+/*!
+ * @brief Depth first search driven by a visitor
+ *
+ * `DiscoverNode` is called when a node is entered, `SkipChildren` leaves it
+ * unexpanded. `ExamineEdge` is called for every edge of an entered node in
+ * turn, `SkipChildren` does not follow it. `FinishNode` is called once
+ * every node reached from it is finished. Any hook may return `Stop`.
+ * Missing hooks cost nothing.
+ *
+ * @param graph Graph
+ * @param start Start node, nothing is visited if it is not in the graph
+ * @param visitor Visitor
+ * @return Whether the visitor stopped the traversal
+ */
+template <NodeType Node, EdgeType Edge, TraversalVisitor<Node, Edge> Visitor>
+bool DFS(const DiGraph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         Visitor&& visitor) {
+  if (graph.Slot(start->Id()) == DiGraph<Node, Edge>::npos) {
+    return false;
+  }
+  // Entered node with the edges left to follow
+  struct Frame {
+    std::shared_ptr<Node> node;
+    std::vector<std::pair<std::shared_ptr<Node>, std::shared_ptr<Edge>>> next;
+    std::size_t pos{0};
+  };
+  std::vector<Frame> frames;
+  utils::VisitedSet visited;
+  visited.Reset(graph.SlotSize());
+
+  const auto enter = [&](const std::shared_ptr<Node>& n) {
+    visited.Insert(graph.Slot(n->Id()));
+    const auto control = detail::DiscoverNode(visitor, n);
+    if (control == VisitControl::Stop) {
+      return false;
+    }
+    auto& frame = frames.emplace_back(Frame{n, {}, 0});
+    if (control != VisitControl::SkipChildren) {
+      detail::ForEachNeighbor(
+          graph, n,
+          [&](const std::shared_ptr<Node>& i, const std::shared_ptr<Edge>& e) {
+            frame.next.emplace_back(i, e);
+          });
+    }
+    return true;
+  };
+
+  if (!enter(start)) {
+    return true;
+  }
+  while (!frames.empty()) {
+    if (auto& frame = frames.back(); frame.pos < frame.next.size()) {
+      const auto [n, e] = frame.next[frame.pos++];
+      if (const auto c = detail::ExamineEdge(visitor, e);
+          c != VisitControl::Continue) {
+        if (c == VisitControl::Stop) {
+          return true;
+        }
+        continue;
+      }
+      if (!visited.Contains(graph.Slot(n->Id())) && !enter(n)) {
+        return true;
+      }
+      continue;
+    }
+
+    const auto n = std::move(frames.back().node);
+    frames.pop_back();
+    if (detail::FinishNode(visitor, n) == VisitControl::Stop) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <NodeType Node, EdgeType Edge, TraversalVisitor<Node, Edge> Visitor>
+bool DFS(const Graph<Node, Edge>& graph, const std::shared_ptr<Node>& start,
+         Visitor&& visitor) {
+  return DFS(static_cast<const DiGraph<Node, Edge>&>(graph), start, visitor);
+}
+
 } // namespace xgraph::algorithm
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "structure/csr.hpp"
+#include "structure/graph.hpp"
+#include "structure/parallel.hpp"
+#include "structure/type_traits.hpp"
+
+namespace xgraph::algorithm {
+
+namespace detail {
+
+/*!
+ * @brief Degree-oriented adjacency of a snapshot
+ *
+ * Directions and weights are ignored, as are self loops and parallel edges.
+ * Every undirected edge is kept once, from its endpoint of lower (degree,
+ * index) to the other, which bounds out degrees by O(sqrt(edges)). Rows stay
+ * sorted by dense index.
+ */
+class OrientedGraph {
+public:
+  /*!
+   * @brief Constructor
+   * @param csr Graph snapshot
+   */
+  template <NodeType Node, EdgeType Edge>
+  explicit OrientedGraph(const CSRGraph<Node, Edge>& csr) {
+    const auto n = csr.NodeSize();
+
+    // Undirected neighbors, merged from out and in rows
+    std::vector<std::size_t> offsets(n + 1, 0);
+    std::vector<std::size_t> neighbors;
+    neighbors.reserve(csr.IsDirected() ? 2 * csr.EdgeSize()
+                                       : csr.EdgeSize());
+    for (std::size_t v = 0; v < n; ++v) {
+      const auto begin = neighbors.size();
+      if (csr.IsDirected()) {
+        std::ranges::set_union(csr.OutNeighbors(v), csr.InNeighbors(v),
+                               std::back_inserter(neighbors));
+      } else {
+        std::ranges::copy(csr.OutNeighbors(v), std::back_inserter(neighbors));
+      }
+      const auto row = std::ranges::subrange(neighbors.begin() + begin,
+                                             neighbors.end());
+      const auto [first, last] = std::ranges::remove(
+          std::ranges::unique(row).begin(), row.end(), v);
+      neighbors.erase(first, last);
+      offsets[v + 1] = neighbors.size();
+    }
+
+    const auto lower = [&offsets](const std::size_t u, const std::size_t v) {
+      const auto du = offsets[u + 1] - offsets[u];
+      const auto dv = offsets[v + 1] - offsets[v];
+      return du < dv || (du == dv && u < v);
+    };
+    _offsets.assign(n + 1, 0);
+    _arcs.reserve(neighbors.size() / 2);
+    for (std::size_t u = 0; u < n; ++u) {
+      for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+        if (lower(u, neighbors[k])) {
+          _arcs.push_back(neighbors[k]);
+        }
+      }
+      _offsets[u + 1] = _arcs.size();
+    }
+  }
+
+  /*!
+   * @brief Get size of nodes
+   * @return Size of nodes
+   */
+  [[nodiscard]] std::size_t NodeSize() const { return _offsets.size() - 1; }
+
+  /*!
+   * @brief Get higher neighbors of the node (sorted)
+   * @param index Dense index of node
+   * @return Dense indices of neighbors
+   */
+  [[nodiscard]] std::span<const std::size_t>
+  Row(const std::size_t index) const {
+    return {_arcs.data() + _offsets[index],
+            _arcs.data() + _offsets[index + 1]};
+  }
+
+  /*!
+   * @brief Enumerate the triangles whose lowest node is `u`
+   * @param u Dense index of node
+   * @param func Callable on (u, v, w), `v` and `w` being higher than `u`
+   */
+  template <typename Func>
+  void Triangles(const std::size_t u, Func&& func) const {
+    const auto row = Row(u);
+    for (const auto v : row) {
+      // Merge of two sorted lists
+      const auto other = Row(v);
+      auto a = row.begin();
+      auto b = other.begin();
+      while (a != row.end() && b != other.end()) {
+        if (*a < *b) {
+          ++a;
+        } else if (*b < *a) {
+          ++b;
+        } else {
+          func(u, v, *a);
+          ++a;
+          ++b;
+        }
+      }
+    }
+  }
+
+private:
+  //! @brief Row offsets, of size `NodeSize() + 1`
+  std::vector<std::size_t> _offsets{0};
+
+  //! @brief Higher neighbors of every node
+  std::vector<std::size_t> _arcs;
+};
+
+} // namespace detail
+
+/*!
+ * @brief Count triangles of a graph
+ *
+ * The graph is seen as undirected. Nodes are spread over worker threads and
+ * each intersects its sorted oriented row with the rows of its neighbors.
+ *
+ * @param csr Graph snapshot
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Number of triangles
+ */
+template <NodeType Node, EdgeType Edge>
+std::size_t CountTriangles(const CSRGraph<Node, Edge>& csr,
+                           const std::size_t threads = 0) {
+  const detail::OrientedGraph oriented(csr);
+  std::vector<std::size_t> counts(
+      std::min(utils::WorkerCount(threads),
+               std::max<std::size_t>(oriented.NodeSize(), 1)),
+      0);
+  utils::ParallelFor(
+      oriented.NodeSize(), threads,
+      [&](const std::size_t worker, const std::size_t u) {
+        auto& count = counts[worker];
+        oriented.Triangles(
+            u, [&count](std::size_t, std::size_t, std::size_t) { ++count; });
+      });
+  return std::reduce(counts.begin(), counts.end());
+}
+
+/*!
+ * @brief Count triangles of a graph
+ * @param graph Graph
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Number of triangles
+ */
+template <NodeType Node, EdgeType Edge>
+std::size_t CountTriangles(const DiGraph<Node, Edge>& graph,
+                           const std::size_t threads = 0) {
+  return CountTriangles(CSRGraph<Node, Edge>(graph), threads);
+}
+
+/*!
+ * @brief Count triangles through every node
+ *
+ * Same traversal as `CountTriangles`, with one count array per worker summed
+ * at the end.
+ *
+ * @param csr Graph snapshot
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Number of triangles of every dense index
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t> NodeTriangles(const CSRGraph<Node, Edge>& csr,
+                                       const std::size_t threads = 0) {
+  const detail::OrientedGraph oriented(csr);
+  const auto n = oriented.NodeSize();
+  std::vector<std::vector<std::size_t>> counts(
+      std::min(utils::WorkerCount(threads), std::max<std::size_t>(n, 1)),
+      std::vector<std::size_t>(n, 0));
+  utils::ParallelFor(n, threads,
+                     [&](const std::size_t worker, const std::size_t u) {
+                       auto& count = counts[worker];
+                       oriented.Triangles(u, [&count](const std::size_t a,
+                                                      const std::size_t b,
+                                                      const std::size_t c) {
+                         ++count[a];
+                         ++count[b];
+                         ++count[c];
+                       });
+                     });
+
+  auto res = std::move(counts.front());
+  for (std::size_t w = 1; w < counts.size(); ++w) {
+    for (std::size_t v = 0; v < n; ++v) {
+      res[v] += counts[w][v];
+    }
+  }
+  return res;
+}
+
+/*!
+ * @brief Count triangles through every node
+ * @param graph Graph
+ * @param threads Number of worker threads (0 for the hardware concurrency)
+ * @return Number of triangles of every dense index of `CSRGraph(graph)` (node
+ * id order)
+ */
+template <NodeType Node, EdgeType Edge>
+std::vector<std::size_t> NodeTriangles(const DiGraph<Node, Edge>& graph,
+                                       const std::size_t threads = 0) {
+  return NodeTriangles(CSRGraph<Node, Edge>(graph), threads);
+}
+
+/*!
+ * @brief List triangles of a graph
+ *
+ * Every triangle is reported once, on the calling thread.
+ *
+ * @param csr Graph snapshot
+ * @param func Callable on the three node pointers of a triangle
+ */
+template <NodeType Node, EdgeType Edge, typename Func>
+void ListTriangles(const CSRGraph<Node, Edge>& csr, Func&& func) {
+  const detail::OrientedGraph oriented(csr);
+  for (std::size_t u = 0; u < oriented.NodeSize(); ++u) {
+    oriented.Triangles(u, [&](const std::size_t a, const std::size_t b,
+                              const std::size_t c) {
+      func(csr.GetNode(a), csr.GetNode(b), csr.GetNode(c));
+    });
+  }
+}
+
+/*!
+ * @brief List triangles of a graph
+ * @param graph Graph
+ * @param func Callable on the three node pointers of a triangle
+ */
+template <NodeType Node, EdgeType Edge, typename Func>
+void ListTriangles(const DiGraph<Node, Edge>& graph, Func&& func) {
+  ListTriangles(CSRGraph<Node, Edge>(graph), std::forward<Func>(func));
+}
+
+} // namespace xgraph::algorithm
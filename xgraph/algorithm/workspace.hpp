@@ -0,0 +1,78 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "structure/visited_set.hpp"
+
+namespace xgraph::algorithm {
+
+/*!
+ * @brief Reusable state of traversals and shortest paths over a `CSRGraph`
+ *
+ * Arrays are indexed by dense index and only the entries stamped in the
+ * current run are valid, so starting a run costs O(1). Buffers only grow,
+ * hence repeated runs on graphs of the same size do not allocate once the
+ * workspace is warm. A workspace must not be shared by concurrent runs.
+ */
+struct Workspace {
+  /*!
+   * @brief Default constructor, buffers grow on first use
+   */
+  Workspace() = default;
+
+  /*!
+   * @brief Constructor sized to a graph
+   * @param size Size of nodes
+   */
+  explicit Workspace(const std::size_t size) { Reserve(size); }
+
+  /*!
+   * @brief Grow buffers for graphs of up to `size` nodes
+   * @param size Size of nodes
+   */
+  void Reserve(const std::size_t size) {
+    reached.Reset(size);
+    if (dist.size() < size) {
+      dist.resize(size);
+      estimate.resize(size);
+      parent.resize(size);
+      indegree.resize(size);
+    }
+    heap.reserve(size);
+    frontier.reserve(size);
+  }
+
+  /*!
+   * @brief Prepare a run
+   * @param size Size of nodes
+   */
+  void Reset(const std::size_t size) {
+    Reserve(size);
+    heap.clear();
+    frontier.clear();
+  }
+
+  //! @brief Nodes reached in the current run
+  utils::VisitedSet reached;
+
+  //! @brief Cost of the best path found to every reached node
+  std::vector<double> dist;
+
+  //! @brief Heuristic value of every reached node
+  std::vector<double> estimate;
+
+  //! @brief Parent of every reached node
+  std::vector<std::size_t> parent;
+
+  //! @brief In degree left of every node during a topological sort
+  std::vector<std::size_t> indegree;
+
+  //! @brief Binary heap of (priority, dense index)
+  std::vector<std::pair<double, std::size_t>> heap;
+
+  //! @brief Queue or stack of dense indices
+  std::vector<std::size_t> frontier;
+};
+
+} // namespace xgraph::algorithm
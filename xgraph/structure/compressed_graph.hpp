@@ -0,0 +1,893 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "csr.hpp"
+#include "graph.hpp"
+
+namespace xgraph {
+
+//! @brief Codec of the gaps of compressed neighbor lists
+enum class AdjacencyCodec : std::uint8_t {
+  //! @brief LEB128 varint, 7 bits per byte
+  Varint,
+  //! @brief StreamVByte, 2 bit length codes of 4 gaps packed in one control
+  //! byte ahead of the gap bytes
+  StreamVByte,
+};
+
+namespace detail {
+
+inline void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::uint8_t>(value));
+}
+
+inline std::uint64_t GetVarint(const std::uint8_t*& in) {
+  std::uint64_t value{0};
+  for (int shift = 0;; shift += 7) {
+    const auto byte = *in++;
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+}
+
+inline std::uint64_t ZigZag(const std::int64_t value) {
+  return static_cast<std::uint64_t>(value) << 1 ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t UnZigZag(const std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+} // namespace detail
+
+/*!
+ * @brief Read-only compressed adjacency of a graph (WebGraph style)
+ *
+ * Nodes keep the dense indices of `CSRGraph`. Every sorted neighbor list is
+ * stored as gaps: the first neighbor relative to the node itself (zigzag
+ * encoded), the others relative to the previous neighbor. With a reference
+ * window, a list may also copy neighbors of one of the previous lists, which
+ * is kept when it encodes shorter. Lists are decoded on the fly while
+ * iterating `OutNeighbors`. Only the structure is stored, edge pointers and
+ * weights are dropped.
+ *
+ * List starts take 32 bits relative to a 64-bit start kept every
+ * `OFFSET_BLOCK` lists. Graphs larger than memory can be built from sorted
+ * arc streams with `FromSortedArcs` and kept on disk with `Save` / `Load`.
+ *
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node = XNode<>, EdgeType Edge = XEdge<>>
+class CompressedGraph {
+  using NodePtr = std::shared_ptr<Node>;
+
+  //! @brief Decoder of the gap encoded (residual) part of a list
+  class Cursor {
+  public:
+    Cursor() = default;
+
+    Cursor(const std::uint8_t* data, const std::size_t size,
+           const std::size_t source, const AdjacencyCodec codec)
+        : _data(data), _size(size), _prev(source), _codec(codec) {
+      if (_codec == AdjacencyCodec::StreamVByte) {
+        _control = _data;
+        _data += (_size + 3) / 4;
+      }
+    }
+
+    [[nodiscard]] bool HasNext() const { return _pos < _size; }
+
+    std::size_t Next() {
+      std::uint64_t gap{0};
+      if (_codec == AdjacencyCodec::Varint) {
+        gap = detail::GetVarint(_data);
+      } else {
+        const unsigned code = _control[_pos >> 2] >> (_pos & 3) * 2 & 3;
+        for (unsigned k = 0; k <= code; ++k) {
+          gap |= static_cast<std::uint64_t>(_data[k]) << k * 8;
+        }
+        _data += code + 1;
+      }
+
+      if (_pos++ == 0) {
+        _prev = static_cast<std::size_t>(static_cast<std::int64_t>(_prev) +
+                                         detail::UnZigZag(gap));
+      } else {
+        _prev += static_cast<std::size_t>(gap) + 1;
+      }
+      return _prev;
+    }
+
+  private:
+    const std::uint8_t* _data{nullptr};
+    const std::uint8_t* _control{nullptr};
+    std::size_t _size{0};
+    std::size_t _pos{0};
+    std::size_t _prev{0};
+    AdjacencyCodec _codec{AdjacencyCodec::Varint};
+  };
+
+  //! @brief Size of lists sharing one 64-bit start
+  static constexpr std::size_t OFFSET_BLOCK = 64;
+
+  //! @brief Encoded lists of one direction
+  struct Rows {
+    //! @brief Encoded lists
+    std::vector<std::uint8_t> bytes;
+
+    //! @brief Start of every `OFFSET_BLOCK`-th list in `bytes`
+    std::vector<std::uint64_t> blocks;
+
+    //! @brief Start of every list relative to the start of its block
+    std::vector<std::uint32_t> offsets;
+
+    /*!
+     * @brief Get the encoded list of a dense index
+     * @param index Dense index
+     * @return First byte of the list
+     */
+    [[nodiscard]] const std::uint8_t* List(const std::size_t index) const {
+      return bytes.data() + blocks[index / OFFSET_BLOCK] + offsets[index];
+    }
+
+    /*!
+     * @brief Append the list of the next dense index
+     * @param list Encoded list
+     * @throw std::length_error if the lists of one block exceed 4 GiB
+     */
+    void Push(std::span<const std::uint8_t> list) {
+      if (offsets.size() % OFFSET_BLOCK == 0) {
+        blocks.push_back(bytes.size());
+      }
+      const auto relative = bytes.size() - blocks.back();
+      if (relative > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("Compressed lists of one block exceed 4 GiB");
+      }
+      offsets.push_back(static_cast<std::uint32_t>(relative));
+      bytes.insert(bytes.end(), list.begin(), list.end());
+    }
+  };
+
+public:
+  /*!
+   * @brief Neighbors of a node, decoded while iterating
+   */
+  class NeighborRange {
+  public:
+    class Iterator {
+    public:
+      using iterator_concept = std::input_iterator_tag;
+      using value_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+
+      explicit Iterator(const NeighborRange& range)
+          : _copied(&range._copied), _cursor(range._cursor),
+            _left(range._size) {
+        if (_cursor.HasNext()) {
+          _head = _cursor.Next();
+          _has_head = true;
+        }
+        Advance();
+      }
+
+      std::size_t operator*() const { return _value; }
+
+      Iterator& operator++() {
+        if (--_left > 0) {
+          Advance();
+        }
+        return *this;
+      }
+
+      void operator++(int) { ++*this; }
+
+      bool operator==(std::default_sentinel_t) const { return _left == 0; }
+
+    private:
+      //! @brief Merge the copied neighbors with the residual ones
+      void Advance() {
+        if (_left == 0) {
+          return;
+        }
+        if (_copied_pos < _copied->size() &&
+            (!_has_head || (*_copied)[_copied_pos] < _head)) {
+          _value = (*_copied)[_copied_pos++];
+          return;
+        }
+        _value = _head;
+        _has_head = _cursor.HasNext();
+        if (_has_head) {
+          _head = _cursor.Next();
+        }
+      }
+
+      const std::vector<std::size_t>* _copied{nullptr};
+      std::size_t _copied_pos{0};
+      Cursor _cursor;
+      std::size_t _head{0};
+      bool _has_head{false};
+      std::size_t _left{0};
+      std::size_t _value{0};
+    };
+
+    /*!
+     * @brief Get iterator to the first neighbor
+     * @return Iterator
+     */
+    [[nodiscard]] Iterator begin() const { return Iterator(*this); }
+
+    /*!
+     * @brief Get end sentinel
+     * @return Sentinel
+     */
+    [[nodiscard]] std::default_sentinel_t end() const { return {}; }
+
+    /*!
+     * @brief Get size of neighbors
+     * @return Size of neighbors
+     */
+    [[nodiscard]] std::size_t size() const { return _size; }
+
+  private:
+    friend class CompressedGraph;
+
+    //! @brief Neighbors copied from the reference list (sorted)
+    std::vector<std::size_t> _copied;
+
+    //! @brief Decoder of the other neighbors
+    Cursor _cursor;
+
+    //! @brief Size of neighbors
+    std::size_t _size{0};
+  };
+
+  //! @brief Index returned for nodes that are not in the graph
+  static constexpr std::size_t npos = CSRGraph<Node, Edge>::npos;
+
+  /*!
+   * @brief Default constructor (empty graph)
+   */
+  CompressedGraph() = default;
+
+  /*!
+   * @brief Compress a snapshot
+   * @param csr Source snapshot
+   * @param codec Codec of gaps
+   * @param window How many previous lists are tried as reference (0 disables
+   * reference compression)
+   * @param max_chain Maximal length of reference chains, bounds the decoding
+   * cost of a list
+   * @throw std::invalid_argument if StreamVByte is used for 2^31 nodes or more
+   */
+  explicit CompressedGraph(const CSRGraph<Node, Edge>& csr,
+                           const AdjacencyCodec codec = AdjacencyCodec::Varint,
+                           const std::size_t window = 0,
+                           const std::size_t max_chain = 3)
+      : _directed(csr.IsDirected()), _version(csr.Version()),
+        _edge_size(csr.EdgeSize()), _codec(codec), _window(window) {
+    _nodes.reserve(csr.NodeSize());
+    for (std::size_t i = 0; i < csr.NodeSize(); ++i) {
+      _nodes.push_back(csr.GetNode(i));
+    }
+    IndexNodes();
+
+    Encode(_out, max_chain,
+           [&csr](const std::size_t i) { return csr.OutNeighbors(i); });
+    if (_directed) {
+      Encode(_in, max_chain,
+             [&csr](const std::size_t i) { return csr.InNeighbors(i); });
+    }
+  }
+
+  /*!
+   * @brief Compress a graph
+   * @param graph Source graph
+   * @param codec Codec of gaps
+   * @param window How many previous lists are tried as reference
+   * @param max_chain Maximal length of reference chains
+   */
+  explicit CompressedGraph(const DiGraph<Node, Edge>& graph,
+                           const AdjacencyCodec codec = AdjacencyCodec::Varint,
+                           const std::size_t window = 0,
+                           const std::size_t max_chain = 3)
+      : CompressedGraph(CSRGraph<Node, Edge>(graph), codec, window,
+                        max_chain) {}
+
+  /*!
+   * @brief Compress a directed graph streamed as sorted arcs
+   *
+   * Lists are encoded as soon as the arcs of their node end, so besides the
+   * output only the lists of the reference window are kept in memory. Arcs
+   * are read once, the in lists from the transposed stream.
+   *
+   * @param nodes Nodes ordered by dense index
+   * @param out Pairs of dense indices (source, target), strictly increasing
+   * @param in Pairs of dense indices (target, source), strictly increasing
+   * @param codec Codec of gaps
+   * @param window How many previous lists are tried as reference
+   * @param max_chain Maximal length of reference chains
+   * @return Compressed graph (version 0)
+   * @throw std::invalid_argument if a stream is not strictly sorted, refers
+   * to an index out of range, or the streams differ in size
+   */
+  template <std::ranges::input_range OutArcs, std::ranges::input_range InArcs>
+  static CompressedGraph
+  FromSortedArcs(std::vector<NodePtr> nodes, OutArcs&& out, InArcs&& in,
+                 const AdjacencyCodec codec = AdjacencyCodec::Varint,
+                 const std::size_t window = 0,
+                 const std::size_t max_chain = 3) {
+    CompressedGraph res(std::move(nodes), true, codec, window);
+    res._edge_size = res.EncodeSorted(res._out, max_chain, out);
+    if (res.EncodeSorted(res._in, max_chain, in) != res._edge_size) {
+      throw std::invalid_argument("In and out arcs differ in size");
+    }
+    return res;
+  }
+
+  /*!
+   * @brief Compress an undirected graph streamed as sorted arcs
+   * @param nodes Nodes ordered by dense index
+   * @param arcs Pairs of dense indices (source, target), strictly increasing,
+   * every edge in both directions
+   * @param codec Codec of gaps
+   * @param window How many previous lists are tried as reference
+   * @param max_chain Maximal length of reference chains
+   * @return Compressed graph (version 0)
+   * @throw std::invalid_argument if the stream is not strictly sorted or
+   * refers to an index out of range
+   */
+  template <std::ranges::input_range Arcs>
+  static CompressedGraph
+  FromSortedArcs(std::vector<NodePtr> nodes, Arcs&& arcs,
+                 const AdjacencyCodec codec = AdjacencyCodec::Varint,
+                 const std::size_t window = 0,
+                 const std::size_t max_chain = 3) {
+    CompressedGraph res(std::move(nodes), false, codec, window);
+    res._edge_size = res.EncodeSorted(res._out, max_chain, arcs);
+    return res;
+  }
+
+  /*!
+   * @brief Write the graph in binary form (native byte order)
+   * @param out Output stream
+   */
+  void Save(std::ostream& out) const {
+    Write(out, MAGIC);
+    Write(out, FORMAT);
+    Write(out, static_cast<std::uint8_t>(_directed));
+    Write(out, static_cast<std::uint8_t>(_codec));
+    Write(out, static_cast<std::uint64_t>(_window));
+    Write(out, static_cast<std::uint64_t>(_version));
+    Write(out, static_cast<std::uint64_t>(_edge_size));
+    Write(out, static_cast<std::uint64_t>(_nodes.size()));
+    for (const auto& n : _nodes) {
+      Write(out, static_cast<std::uint64_t>(n->Id()));
+    }
+    WriteRows(out, _out);
+    if (_directed) {
+      WriteRows(out, _in);
+    }
+  }
+
+  /*!
+   * @brief Read a graph written by `Save`
+   * @param in Input stream
+   * @param graph Graph providing the nodes
+   * @return Compressed graph
+   * @throw std::runtime_error if the data is malformed or a node is missing
+   */
+  static CompressedGraph Load(std::istream& in,
+                              const DiGraph<Node, Edge>& graph) {
+    return LoadWith(in, [&graph](std::size_t, const std::size_t id) {
+      return graph.GetNode(id);
+    });
+  }
+
+  /*!
+   * @brief Read a graph written by `Save`
+   * @param in Input stream
+   * @param nodes Nodes ordered by dense index, as when saved
+   * @return Compressed graph
+   * @throw std::runtime_error if the data is malformed or the nodes differ
+   */
+  static CompressedGraph Load(std::istream& in,
+                              const std::vector<NodePtr>& nodes) {
+    return LoadWith(in, [&nodes](const std::size_t i, const std::size_t id) {
+      return i < nodes.size() && nodes[i]->Id() == id ? nodes[i] : nullptr;
+    });
+  }
+
+  /*!
+   * @brief Whether the source graph is directed
+   * @return Boolean
+   */
+  [[nodiscard]] bool IsDirected() const { return _directed; }
+
+  /*!
+   * @brief Version of the source graph when the snapshot was built
+   * @return Version
+   */
+  [[nodiscard]] std::size_t Version() const { return _version; }
+
+  /*!
+   * @brief Get size of nodes
+   * @return Size of nodes
+   */
+  [[nodiscard]] std::size_t NodeSize() const { return _nodes.size(); }
+
+  /*!
+   * @brief Get size of stored arcs (twice the edges for undirected graphs)
+   * @return Size of arcs
+   */
+  [[nodiscard]] std::size_t EdgeSize() const { return _edge_size; }
+
+  /*!
+   * @brief Get size of the encoded adjacency in bytes (lists and offsets)
+   * @return Size in bytes
+   */
+  [[nodiscard]] std::size_t ByteSize() const {
+    return _out.bytes.size() + _in.bytes.size() +
+           (_out.blocks.size() + _in.blocks.size()) * sizeof(std::uint64_t) +
+           (_out.offsets.size() + _in.offsets.size()) * sizeof(std::uint32_t);
+  }
+
+  /*!
+   * @brief Get dense index of node id
+   * @param id Node id
+   * @return Dense index if exists else `npos`
+   */
+  [[nodiscard]] std::size_t Index(const std::size_t& id) const {
+    if (const auto it = _index.find(id); it != _index.end()) {
+      return it->second;
+    }
+    return npos;
+  }
+
+  /*!
+   * @brief Get dense index of node ptr
+   * @param n Node ptr
+   * @return Dense index if exists else `npos`
+   */
+  [[nodiscard]] std::size_t Index(const NodePtr& n) const {
+    return Index(n->Id());
+  }
+
+  /*!
+   * @brief Get node ptr of dense index
+   * @param index Dense index
+   * @return Node ptr
+   */
+  const NodePtr& GetNode(const std::size_t index) const {
+    return _nodes[index];
+  }
+
+  /*!
+   * @brief Get out neighbors of the node (sorted, decoded while iterating)
+   * @param index Dense index
+   * @return Range of dense indices
+   */
+  [[nodiscard]] NeighborRange OutNeighbors(const std::size_t index) const {
+    return Decode(_out, index);
+  }
+
+  /*!
+   * @brief Get in neighbors of the node (sorted, decoded while iterating)
+   * @param index Dense index
+   * @return Range of dense indices
+   */
+  [[nodiscard]] NeighborRange InNeighbors(const std::size_t index) const {
+    return Decode(_directed ? _in : _out, index);
+  }
+
+  /*!
+   * @brief Get out degree of the node
+   * @param index Dense index
+   * @return Out degree
+   */
+  [[nodiscard]] std::size_t OutDegree(const std::size_t index) const {
+    auto in = _out.List(index);
+    return static_cast<std::size_t>(detail::GetVarint(in));
+  }
+
+private:
+  //! @brief Tag of the binary form
+  static constexpr std::uint32_t MAGIC = 0x47435847;
+
+  //! @brief Version of the binary form
+  static constexpr std::uint32_t FORMAT = 1;
+
+  /*!
+   * @brief Constructor of an empty graph over nodes, lists are encoded after
+   */
+  CompressedGraph(std::vector<NodePtr> nodes, const bool directed,
+                  const AdjacencyCodec codec, const std::size_t window)
+      : _directed(directed), _codec(codec), _window(window),
+        _nodes(std::move(nodes)) {
+    IndexNodes();
+  }
+
+  /*!
+   * @brief Fill the node index
+   * @throw std::invalid_argument if StreamVByte is used for 2^31 nodes or more
+   */
+  void IndexNodes() {
+    if (_codec == AdjacencyCodec::StreamVByte &&
+        _nodes.size() >= std::size_t{1} << 31) {
+      throw std::invalid_argument("Too many nodes for StreamVByte gaps");
+    }
+    _index.reserve(_nodes.size());
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+      _index.emplace(_nodes[i]->Id(), i);
+    }
+  }
+
+  /*!
+   * @brief Encode the lists of one direction
+   * @param rows Output
+   * @param max_chain Maximal length of reference chains
+   * @param row Callable returning the sorted list of a dense index
+   */
+  template <typename RowFunc>
+  void Encode(Rows& rows, const std::size_t max_chain, RowFunc&& row) {
+    const auto n = _nodes.size();
+    rows.offsets.reserve(n);
+    std::vector<std::size_t> chain;
+    chain.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      EncodeNext(rows, chain, max_chain, row(i), row);
+    }
+  }
+
+  /*!
+   * @brief Encode the lists of one direction from sorted arcs
+   * @param rows Output
+   * @param max_chain Maximal length of reference chains
+   * @param arcs Pairs of dense indices, strictly increasing
+   * @return Size of arcs
+   * @throw std::invalid_argument if arcs are not strictly increasing or refer
+   * to an index out of range
+   */
+  template <typename Arcs>
+  std::size_t EncodeSorted(Rows& rows, const std::size_t max_chain,
+                           Arcs&& arcs) {
+    const auto n = _nodes.size();
+    rows.offsets.reserve(n);
+    std::vector<std::size_t> chain;
+    chain.reserve(n);
+
+    // Lists of the reference window, the current one included
+    std::vector<std::vector<std::size_t>> recent(_window + 1);
+    const auto row = [&recent](const std::size_t i) {
+      return std::span<const std::size_t>(recent[i % recent.size()]);
+    };
+    std::size_t current{0};
+    const auto finish = [&] {
+      EncodeNext(rows, chain, max_chain, row(current), row);
+      if (++current < n) {
+        recent[current % recent.size()].clear();
+      }
+    };
+
+    std::size_t size{0};
+    for (const auto& [first, second] : arcs) {
+      const auto s = static_cast<std::size_t>(first);
+      const auto t = static_cast<std::size_t>(second);
+      if (s >= n || t >= n) {
+        throw std::invalid_argument("Arc endpoint is not a dense index");
+      }
+      if (s < current || (s == current && !row(s).empty() &&
+                          t <= row(s).back())) {
+        throw std::invalid_argument("Arcs are not strictly increasing");
+      }
+      while (current < s) {
+        finish();
+      }
+      recent[s % recent.size()].push_back(t);
+      ++size;
+    }
+    while (current < n) {
+      finish();
+    }
+    return size;
+  }
+
+  /*!
+   * @brief Encode the list of the next dense index, trying the lists of the
+   * window as reference
+   * @param rows Output
+   * @param chain Reference chain length of every encoded list
+   * @param max_chain Maximal length of reference chains
+   * @param list Sorted neighbors
+   * @param row Callable returning the sorted list of a previous dense index
+   */
+  template <typename RowFunc>
+  void EncodeNext(Rows& rows, std::vector<std::size_t>& chain,
+                  const std::size_t max_chain,
+                  std::span<const std::size_t> list, RowFunc&& row) {
+    const auto i = chain.size();
+    std::vector<std::uint8_t> best;
+    EncodeList(best, i, list, 0, {});
+    chain.push_back(0);
+
+    std::vector<std::uint8_t> candidate;
+    for (std::size_t d = 1; d <= std::min(_window, i); ++d) {
+      if (chain[i - d] >= max_chain) {
+        continue;
+      }
+      candidate.clear();
+      EncodeList(candidate, i, list, d, row(i - d));
+      if (candidate.size() < best.size()) {
+        std::swap(best, candidate);
+        chain[i] = chain[i - d] + 1;
+      }
+    }
+    rows.Push(best);
+  }
+
+  /*!
+   * @brief Encode one list
+   *
+   * Layout: degree, then with a reference window the reference distance
+   * (0 for none) followed by the lengths of alternating copy / skip blocks
+   * over the reference list, then the gaps of the remaining neighbors.
+   *
+   * @param out Output
+   * @param source Dense index of the list
+   * @param list Sorted neighbors
+   * @param distance Distance to the reference list (0 for none)
+   * @param reference Sorted neighbors of the reference list
+   */
+  void EncodeList(std::vector<std::uint8_t>& out, const std::size_t source,
+                  std::span<const std::size_t> list,
+                  const std::size_t distance,
+                  std::span<const std::size_t> reference) const {
+    detail::PutVarint(out, list.size());
+
+    std::vector<std::size_t> residual;
+    if (_window > 0) {
+      detail::PutVarint(out, distance);
+    }
+    if (distance > 0) {
+      // Lengths of blocks, starting with a copy block, trailing skip dropped
+      std::vector<std::size_t> blocks;
+      bool copying{true};
+      std::size_t length{0};
+      for (const auto v : reference) {
+        if (std::ranges::binary_search(list, v) != copying) {
+          blocks.push_back(length);
+          copying = !copying;
+          length = 0;
+        }
+        ++length;
+      }
+      if (copying) {
+        blocks.push_back(length);
+      }
+      detail::PutVarint(out, blocks.size());
+      for (const auto b : blocks) {
+        detail::PutVarint(out, b);
+      }
+      std::ranges::set_difference(list, reference,
+                                  std::back_inserter(residual));
+      list = residual;
+    }
+
+    // Gaps of the remaining neighbors
+    const auto gap = [source, &list](const std::size_t k) -> std::uint64_t {
+      if (k == 0) {
+        return detail::ZigZag(static_cast<std::int64_t>(list[0]) -
+                              static_cast<std::int64_t>(source));
+      }
+      return list[k] - list[k - 1] - 1;
+    };
+    if (_codec == AdjacencyCodec::Varint) {
+      for (std::size_t k = 0; k < list.size(); ++k) {
+        detail::PutVarint(out, gap(k));
+      }
+      return;
+    }
+
+    const auto control = out.size();
+    out.resize(out.size() + (list.size() + 3) / 4, 0);
+    for (std::size_t k = 0; k < list.size(); ++k) {
+      auto value = gap(k);
+      std::uint8_t code{0};
+      while (value > 0xff) {
+        out.push_back(static_cast<std::uint8_t>(value));
+        value >>= 8;
+        ++code;
+      }
+      out.push_back(static_cast<std::uint8_t>(value));
+      out[control + k / 4] |= static_cast<std::uint8_t>(code << k % 4 * 2);
+    }
+  }
+
+  /*!
+   * @brief Prepare the decoding of one list
+   * @param rows Lists of one direction
+   * @param index Dense index
+   * @return Range of neighbors
+   */
+  NeighborRange Decode(const Rows& rows, const std::size_t index) const {
+    NeighborRange res;
+    auto in = rows.List(index);
+    res._size = static_cast<std::size_t>(detail::GetVarint(in));
+
+    std::size_t distance{0};
+    if (_window > 0) {
+      distance = static_cast<std::size_t>(detail::GetVarint(in));
+    }
+    if (distance > 0) {
+      const auto block_size = detail::GetVarint(in);
+      std::size_t copy_left{0};
+      bool copying{false};
+      std::uint64_t read{0};
+      for (const auto v : Decode(rows, index - distance)) {
+        while (copy_left == 0 && read < block_size) {
+          copy_left = static_cast<std::size_t>(detail::GetVarint(in));
+          copying = read++ % 2 == 0;
+        }
+        if (copy_left == 0) {
+          break;
+        }
+        if (copying) {
+          res._copied.push_back(v);
+        }
+        --copy_left;
+      }
+      // Skip unread block lengths (only when the reference ended early)
+      for (; read < block_size; ++read) {
+        detail::GetVarint(in);
+      }
+    }
+
+    res._cursor = Cursor(in, res._size - res._copied.size(), index, _codec);
+    return res;
+  }
+
+  /*!
+   * @brief Read a graph written by `Save`
+   * @param in Input stream
+   * @param node_of Callable on (dense index, node id) returning the node ptr,
+   * nullptr if missing
+   * @return Compressed graph
+   */
+  template <typename NodeFunc>
+  static CompressedGraph LoadWith(std::istream& in, NodeFunc&& node_of) {
+    if (Read<std::uint32_t>(in) != MAGIC ||
+        Read<std::uint32_t>(in) != FORMAT) {
+      throw std::runtime_error("Not a compressed graph");
+    }
+
+    CompressedGraph res;
+    res._directed = Read<std::uint8_t>(in) != 0;
+    const auto codec = Read<std::uint8_t>(in);
+    if (codec > static_cast<std::uint8_t>(AdjacencyCodec::StreamVByte)) {
+      throw std::runtime_error("Unknown compressed graph codec");
+    }
+    res._codec = static_cast<AdjacencyCodec>(codec);
+    res._window = static_cast<std::size_t>(Read<std::uint64_t>(in));
+    res._version = static_cast<std::size_t>(Read<std::uint64_t>(in));
+    res._edge_size = static_cast<std::size_t>(Read<std::uint64_t>(in));
+
+    const auto n = static_cast<std::size_t>(Read<std::uint64_t>(in));
+    res._nodes.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto id = static_cast<std::size_t>(Read<std::uint64_t>(in));
+      auto node = node_of(i, id);
+      if (!node) {
+        throw std::runtime_error("Compressed graph node not found");
+      }
+      res._nodes.push_back(std::move(node));
+    }
+    res.IndexNodes();
+
+    ReadRows(in, res._out, n);
+    if (res._directed) {
+      ReadRows(in, res._in, n);
+    }
+    return res;
+  }
+
+  static void WriteRows(std::ostream& out, const Rows& rows) {
+    Write(out, static_cast<std::uint64_t>(rows.bytes.size()));
+    WriteVector(out, rows.bytes);
+    WriteVector(out, rows.blocks);
+    WriteVector(out, rows.offsets);
+  }
+
+  static void ReadRows(std::istream& in, Rows& rows, const std::size_t n) {
+    const auto size = static_cast<std::size_t>(Read<std::uint64_t>(in));
+    ReadVector(in, rows.bytes, size);
+    ReadVector(in, rows.blocks, (n + OFFSET_BLOCK - 1) / OFFSET_BLOCK);
+    ReadVector(in, rows.offsets, n);
+    for (std::size_t i = 0; i < n; ++i) {
+      if (rows.blocks[i / OFFSET_BLOCK] + rows.offsets[i] >= size) {
+        throw std::runtime_error("Malformed compressed graph");
+      }
+    }
+  }
+
+  template <typename T> static void Write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  static void WriteVector(std::ostream& out, const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(reinterpret_cast<const char*>(values.data()),
+              static_cast<std::streamsize>(values.size() * sizeof(T)));
+  }
+
+  template <typename T> static T Read(std::istream& in) {
+    T value{};
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+      throw std::runtime_error("Truncated compressed graph");
+    }
+    return value;
+  }
+
+  template <typename T>
+  static void ReadVector(std::istream& in, std::vector<T>& values,
+                         const std::size_t size) {
+    values.resize(size);
+    if (!in.read(reinterpret_cast<char*>(values.data()),
+                 static_cast<std::streamsize>(size * sizeof(T)))) {
+      throw std::runtime_error("Truncated compressed graph");
+    }
+  }
+
+  //! @brief Whether the source graph is directed
+  bool _directed{true};
+
+  //! @brief Version of the source graph
+  std::size_t _version{0};
+
+  //! @brief Size of arcs
+  std::size_t _edge_size{0};
+
+  //! @brief Codec of gaps
+  AdjacencyCodec _codec{AdjacencyCodec::Varint};
+
+  //! @brief Reference window (0 if reference compression is disabled)
+  std::size_t _window{0};
+
+  //! @brief Nodes ordered by dense index
+  std::vector<NodePtr> _nodes;
+
+  //! @brief Node id to dense index
+  std::unordered_map<std::size_t, std::size_t> _index;
+
+  //! @brief Out lists
+  Rows _out;
+
+  //! @brief In lists (empty for undirected graphs, which reuse out lists)
+  Rows _in;
+};
+
+} // namespace xgraph
@@ -0,0 +1,1033 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "edge.hpp"
+#include "node.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+
+namespace xgraph {
+
+/*!
+ * @brief Thread-safe directed graph with sharded locking and MVCC snapshots
+ *
+ * Nodes are partitioned into shards by id, every shard owns the nodes and
+ * their in/out adjacency rows behind one `std::shared_mutex`. Names are
+ * partitioned separately by their hash. Readers of different shards never
+ * contend, readers of the same shard share the lock, and a writer only blocks
+ * the one or two shards it touches.
+ *
+ * Every effective modification is committed with a new version. A node keeps
+ * a chain of versions whose adjacency rows are immutable and replaced
+ * copy-on-write, so `Snapshot()` gives a consistent view of the graph at the
+ * last committed version while writers keep going. Old versions are reclaimed
+ * once no snapshot pins an epoch (version) that can still observe them.
+ *
+ * Unlike `DiGraph`, there is at most one edge per (source, target) pair and
+ * queries return `std::vector` copies taken under the shard lock. Adding or
+ * removing an edge copies the touched rows, so it costs O(degree).
+ *
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node = XNode<>, EdgeType Edge = XEdge<>>
+class ConcurrentDiGraph {
+  using NodePtr = std::shared_ptr<Node>;
+  using EdgePtr = std::shared_ptr<Edge>;
+
+  //! @brief Immutable adjacency row sorted by neighbor id
+  using EdgeRow = std::vector<std::pair<std::size_t, EdgePtr>>;
+  using EdgeRowPtr = std::shared_ptr<const EdgeRow>;
+
+  //! @brief Version used to read the newest state
+  static constexpr std::uint64_t LATEST =
+      std::numeric_limits<std::uint64_t>::max();
+
+  //! @brief Number of retired versions that triggers a reclamation
+  static constexpr std::size_t RECLAIM_THRESHOLD = 4096;
+
+public:
+  class GraphSnapshot;
+
+  /*!
+   * @brief Constructor
+   * @param shard_num Number of shards (rounded up to a power of two)
+   */
+  explicit ConcurrentDiGraph(const std::size_t shard_num = 64)
+      : _shard_num(std::bit_ceil(shard_num == 0 ? 1 : shard_num)),
+        _shards(std::make_unique<Shard[]>(_shard_num)),
+        _name_shards(std::make_unique<NameShard[]>(_shard_num)),
+        _empty_row(std::make_shared<const EdgeRow>()) {}
+
+  ConcurrentDiGraph(const ConcurrentDiGraph& other) = delete;
+
+  ConcurrentDiGraph(ConcurrentDiGraph&& other) = delete;
+
+  ConcurrentDiGraph& operator=(const ConcurrentDiGraph& other) = delete;
+
+  ConcurrentDiGraph& operator=(ConcurrentDiGraph&& other) = delete;
+
+  /*!
+   * @brief Default destructor (all snapshots must be released before)
+   */
+  ~ConcurrentDiGraph() = default;
+
+  /*!
+   * @brief Whether the graph is directed
+   * @return true
+   */
+  [[nodiscard]] bool IsDirected() const { return true; }
+
+  /*!
+   * @brief Get last committed version
+   * @return Version
+   */
+  [[nodiscard]] std::uint64_t Version() const {
+    return _committed.load(std::memory_order_acquire);
+  }
+
+  /*!
+   * @brief Take a consistent read-only view at the last committed version
+   * @return Snapshot (pins its version until destroyed)
+   */
+  GraphSnapshot Snapshot() {
+    std::lock_guard lock(_pin_mutex);
+    const auto version = Version();
+    _pinned.insert(version);
+    return GraphSnapshot(this, version);
+  }
+
+  /*!
+   * @brief Free node versions that no snapshot can observe anymore
+   * @note Called automatically after enough modifications, and when releasing
+   * a snapshot moves the oldest pinned version past the last reclamation
+   */
+  void Reclaim() {
+    std::uint64_t bound;
+    {
+      std::lock_guard lock(_pin_mutex);
+      bound = _pinned.empty() ? Version() : *_pinned.begin();
+    }
+    for (auto last = _reclaimed_bound.load(std::memory_order_relaxed);
+         last < bound && !_reclaimed_bound.compare_exchange_weak(
+                             last, bound, std::memory_order_relaxed);) {
+    }
+
+    for (std::size_t i = 0; i < _shard_num; ++i) {
+      auto& shard = _shards[i];
+      // Shards without retired versions are skipped without locking, a
+      // version retired meanwhile waits for the next reclamation
+      if (shard.retired_size.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      std::unique_lock lock(shard.mutex);
+
+      std::ranges::sort(shard.retired);
+      const auto [first, last] = std::ranges::unique(shard.retired);
+      shard.retired.erase(first, last);
+
+      std::vector<std::size_t> pending;
+      for (const auto id : shard.retired) {
+        const auto it = shard.nodes.find(id);
+        if (it == shard.nodes.end()) {
+          continue;
+        }
+
+        // Newest version visible at the bound, older ones are unreachable
+        auto& head = it->second.head;
+        auto* visible = head.get();
+        while (visible != nullptr && visible->version > bound) {
+          visible = visible->prev.get();
+        }
+        if (visible == nullptr) {
+          pending.push_back(id);
+          continue;
+        }
+
+        _version_size -= Release(visible->prev);
+        if (visible != head.get()) {
+          pending.push_back(id);
+        } else if (visible->node == nullptr) {
+          _version_size -= Release(head);
+          shard.nodes.erase(it);
+        }
+      }
+      shard.retired = std::move(pending);
+      shard.retired_size.store(shard.retired.size(),
+                               std::memory_order_relaxed);
+    }
+  }
+
+  /*!
+   * @brief Get number of node versions kept in memory
+   * @return Number of versions
+   */
+  [[nodiscard]] std::size_t RetainedVersions() const {
+    return _version_size.load();
+  }
+
+  /*!
+   * @brief Add node ptr (no effect if exists already)
+   * @param n Node ptr
+   */
+  void AddNode(const NodePtr& n) {
+    EpochGuard epoch(*this);
+    std::uint64_t version;
+    {
+      auto& shard = ShardOf(n->Id());
+      std::unique_lock lock(shard.mutex);
+      auto& record = shard.nodes[n->Id()];
+      if (IsLive(record.head.get())) {
+        return;
+      }
+
+      version = epoch.Begin();
+      Install(shard, record, n->Id(), version, n, _empty_row, _empty_row);
+      ++_node_size;
+
+      // Still under the node's shard lock, so a concurrent removal of the
+      // node cannot run between installing it and indexing its name
+      auto& name_shard = NameShardOf(n->Name());
+      std::unique_lock name_lock(name_shard.mutex);
+      // Re-insert so that the key views the name of the stored node
+      if (const auto it = name_shard.names.find(n->Name());
+          it != name_shard.names.end()) {
+        name_shard.names.erase(it);
+      }
+      name_shard.names.emplace(NodeNameKey_t<Node>(n->Name()), n);
+    }
+    epoch.Commit();
+  }
+
+  /*!
+   * @brief Construct and add node ptr
+   * @tparam Args Arguments type (NOT NodePtr) to construct node
+   * @param args Arguments to construct node
+   */
+  template <typename... Args>
+    requires(!std::is_same_v<std::decay_t<Args>, NodePtr> && ...)
+  void AddNode(Args&&... args) {
+    AddNode(std::make_shared<Node>(std::forward<Args>(args)...));
+  }
+
+  /*!
+   * @brief Remove node and all edges bind to it
+   * @note Locks every shard, removal is expected to be rare
+   * @param id Node id
+   */
+  void RemoveNode(const std::size_t& id) {
+    EpochGuard epoch(*this);
+    std::uint64_t version;
+    {
+      std::vector<std::unique_lock<std::shared_mutex>> locks;
+      locks.reserve(_shard_num);
+      for (std::size_t i = 0; i < _shard_num; ++i) {
+        locks.emplace_back(_shards[i].mutex);
+      }
+
+      auto& shard = ShardOf(id);
+      const auto it = shard.nodes.find(id);
+      if (it == shard.nodes.end() || !IsLive(it->second.head.get())) {
+        return;
+      }
+
+      version = epoch.Begin();
+      const auto& head = *it->second.head;
+      const auto node = head.node;
+      const auto out = head.out;
+      const auto in = head.in;
+
+      for (const auto& [t_id, _] : *out) {
+        if (t_id != id) {
+          auto& row = Writable(ShardOf(t_id), t_id, version).in;
+          row = Erased(row, id);
+        }
+        --_edge_size;
+      }
+      for (const auto& [s_id, _] : *in) {
+        if (s_id != id) {
+          auto& row = Writable(ShardOf(s_id), s_id, version).out;
+          row = Erased(row, id);
+          --_edge_size;
+        }
+      }
+
+      Install(shard, it->second, id, version, nullptr, _empty_row,
+              _empty_row);
+      --_node_size;
+
+      // Name shards are always locked after node shards
+      auto& name_shard = NameShardOf(node->Name());
+      std::unique_lock name_lock(name_shard.mutex);
+      if (const auto n = name_shard.names.find(node->Name());
+          n != name_shard.names.end() && n->second.lock() == node) {
+        name_shard.names.erase(n);
+      }
+    }
+    epoch.Commit();
+  }
+
+  /*!
+   * @brief Remove node and all edges bind to it
+   * @param name Node name
+   */
+  void RemoveNode(const std::string_view name) {
+    if (const auto n = GetNode(name)) {
+      RemoveNode(n->Id());
+    }
+  }
+
+  /*!
+   * @brief Add edge ptr (no effect if the pair exists already or any
+   * endpoint is not in the graph)
+   * @param e Edge ptr
+   */
+  void AddEdge(const EdgePtr& e) {
+    const auto s_id = e->Source()->Id();
+    const auto t_id = e->Target()->Id();
+
+    EpochGuard epoch(*this);
+    std::uint64_t version;
+    {
+      const auto locks = LockPair(s_id, t_id);
+      const auto* s = Head(ShardOf(s_id), s_id);
+      const auto* t = Head(ShardOf(t_id), t_id);
+      if (!IsLive(s) || !IsLive(t) || Find(*s->out, t_id) != nullptr) {
+        return;
+      }
+
+      version = epoch.Begin();
+      auto& out = Writable(ShardOf(s_id), s_id, version).out;
+      out = Inserted(out, t_id, e);
+      auto& in = Writable(ShardOf(t_id), t_id, version).in;
+      in = Inserted(in, s_id, e);
+      ++_edge_size;
+    }
+    epoch.Commit();
+  }
+
+  /*!
+   * @brief Construct and add edge ptr
+   * @tparam Args Auxiliary arguments type to construct edge
+   * @param s_id source node id
+   * @param t_id target node id
+   * @param args Auxiliary arguments to construct edge
+   */
+  template <typename... Args>
+  void AddEdge(const std::size_t& s_id, const std::size_t& t_id,
+               Args&&... args) {
+    const auto s_node_ptr = GetNode(s_id);
+    const auto t_node_ptr = GetNode(t_id);
+    if (s_node_ptr && t_node_ptr) {
+      AddEdge(std::make_shared<Edge>(std::weak_ptr<Node>(s_node_ptr),
+                                     std::weak_ptr<Node>(t_node_ptr),
+                                     std::forward<Args>(args)...));
+    }
+  }
+
+  /*!
+   * @brief Construct and add edge ptr
+   * @tparam Args Auxiliary arguments type to construct edge
+   * @param s_name source node name
+   * @param t_name target node name
+   * @param args Auxiliary arguments to construct edge
+   */
+  template <typename... Args>
+  void AddEdge(const std::string_view s_name, const std::string_view t_name,
+               Args&&... args) {
+    const auto s_node_ptr = GetNode(s_name);
+    const auto t_node_ptr = GetNode(t_name);
+    if (s_node_ptr && t_node_ptr) {
+      AddEdge(std::make_shared<Edge>(std::weak_ptr<Node>(s_node_ptr),
+                                     std::weak_ptr<Node>(t_node_ptr),
+                                     std::forward<Args>(args)...));
+    }
+  }
+
+  /*!
+   * @brief Remove edge
+   * @param s_id Source node id
+   * @param t_id Target node id
+   */
+  void RemoveEdge(const std::size_t& s_id, const std::size_t& t_id) {
+    EpochGuard epoch(*this);
+    std::uint64_t version;
+    {
+      const auto locks = LockPair(s_id, t_id);
+      const auto* s = Head(ShardOf(s_id), s_id);
+      if (!IsLive(s) || Find(*s->out, t_id) == nullptr) {
+        return;
+      }
+
+      version = epoch.Begin();
+      auto& out = Writable(ShardOf(s_id), s_id, version).out;
+      out = Erased(out, t_id);
+      auto& in = Writable(ShardOf(t_id), t_id, version).in;
+      in = Erased(in, s_id);
+      --_edge_size;
+    }
+    epoch.Commit();
+  }
+
+  /*!
+   * @brief Get node ptr according to id
+   * @param id Node id
+   * @return Node ptr if exists else nullptr
+   */
+  NodePtr GetNode(const std::size_t& id) const {
+    return Read(id, LATEST, [](const NodeVersion* v) { return v->node; },
+                NodePtr());
+  }
+
+  /*!
+   * @brief Get node ptr according to name
+   * @param name Node name
+   * @return Node ptr if exists else nullptr
+   */
+  NodePtr GetNode(const std::string_view name) const {
+    const auto& shard = NameShardOf(name);
+    std::shared_lock lock(shard.mutex);
+    if (const auto it = shard.names.find(name); it != shard.names.end()) {
+      return it->second.lock();
+    }
+    return nullptr;
+  }
+
+  /*!
+   * @brief Whether there has the node
+   * @tparam T Argument type that can convert to call `GetNode`
+   * @param arg Argument refer to node
+   * @return True if there has the node else false
+   */
+  template <typename T>
+    requires(std::convertible_to<T, std::string_view> ||
+             std::convertible_to<T, std::size_t>)
+  [[nodiscard]] bool HasNode(T&& arg) const {
+    return GetNode(std::forward<T>(arg)) != nullptr;
+  }
+
+  /*!
+   * @brief Get edge ptr
+   * @param s_id Source node id
+   * @param t_id Target node id
+   * @return Edge ptr if exists else nullptr
+   */
+  EdgePtr GetEdge(const std::size_t& s_id, const std::size_t& t_id) const {
+    return FindEdge(s_id, t_id, LATEST);
+  }
+
+  /*!
+   * @brief Whether there has the edge
+   * @param s_id Source node id
+   * @param t_id Target node id
+   * @return True if there has the edge else false
+   */
+  [[nodiscard]] bool HasEdge(const std::size_t& s_id,
+                             const std::size_t& t_id) const {
+    return GetEdge(s_id, t_id) != nullptr;
+  }
+
+  /*!
+   * @brief Get copy of all nodes
+   * @return Nodes
+   */
+  std::vector<NodePtr> Nodes() const { return CollectNodes(LATEST); }
+
+  /*!
+   * @brief Get size of nodes
+   * @return Size of nodes
+   */
+  [[nodiscard]] std::size_t NodeSize() const { return _node_size.load(); }
+
+  /*!
+   * @brief Get size of edges
+   * @return Size of edges
+   */
+  [[nodiscard]] std::size_t EdgeSize() const { return _edge_size.load(); }
+
+  /*!
+   * @brief Get in edges from the node
+   * @param id Node id
+   * @return In edges
+   */
+  std::vector<EdgePtr> InEdges(const std::size_t& id) const {
+    return CopyRow(id, LATEST, &NodeVersion::in);
+  }
+
+  /*!
+   * @brief Get out edges from the node
+   * @param id Node id
+   * @return Out edges
+   */
+  std::vector<EdgePtr> OutEdges(const std::size_t& id) const {
+    return CopyRow(id, LATEST, &NodeVersion::out);
+  }
+
+  /*!
+   * @brief Get all parents nodes ptr from the node
+   * @param id Node id
+   * @return Parents nodes
+   */
+  std::vector<NodePtr> Parents(const std::size_t& id) const {
+    return Ends(InEdges(id), &Edge::Source);
+  }
+
+  /*!
+   * @brief Get all children nodes ptr from the node
+   * @param id Node id
+   * @return Children nodes
+   */
+  std::vector<NodePtr> Children(const std::size_t& id) const {
+    return Ends(OutEdges(id), &Edge::Target);
+  }
+
+private:
+  //! @brief One version of a node and its adjacency rows
+  struct NodeVersion {
+    //! @brief Version that created this state
+    std::uint64_t version;
+
+    //! @brief Node owner (nullptr if the node is removed)
+    NodePtr node;
+
+    //! @brief Out edges keyed by target id
+    EdgeRowPtr out;
+
+    //! @brief In edges keyed by source id
+    EdgeRowPtr in;
+
+    //! @brief Previous version
+    std::unique_ptr<NodeVersion> prev;
+  };
+
+  //! @brief Version chain of a node (newest first)
+  struct NodeRecord {
+    NodeRecord() = default;
+
+    NodeRecord(const NodeRecord& other) = delete;
+
+    NodeRecord& operator=(const NodeRecord& other) = delete;
+
+    ~NodeRecord() { Release(head); }
+
+    std::unique_ptr<NodeVersion> head;
+  };
+
+  //! @brief Shard of nodes (aligned to avoid false sharing of the locks)
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::size_t, NodeRecord> nodes;
+
+    //! @brief Ids of nodes whose version chain may be truncated
+    std::vector<std::size_t> retired;
+
+    //! @brief Size of `retired`, readable without the lock
+    std::atomic<std::size_t> retired_size{0};
+  };
+
+  //! @brief Shard of node names
+  struct alignas(64) NameShard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<NodeNameKey_t<Node>, std::weak_ptr<Node>,
+                       utils::StringHash, std::equal_to<>>
+        names;
+  };
+
+  [[nodiscard]] std::size_t ShardIndex(const std::size_t hash) const {
+    // Fibonacci hashing spreads sequential ids over the shards
+    return (hash * 0x9E3779B97F4A7C15ULL >> 32) & (_shard_num - 1);
+  }
+
+  Shard& ShardOf(const std::size_t id) { return _shards[ShardIndex(id)]; }
+
+  const Shard& ShardOf(const std::size_t id) const {
+    return _shards[ShardIndex(id)];
+  }
+
+  NameShard& NameShardOf(const std::string_view name) const {
+    return _name_shards[ShardIndex(utils::StringHash{}(name))];
+  }
+
+  /*!
+   * @brief Exclusively lock shards of two nodes in a deadlock free order
+   * @param s_id Source node id
+   * @param t_id Target node id
+   * @return Locks
+   */
+  std::pair<std::unique_lock<std::shared_mutex>,
+            std::unique_lock<std::shared_mutex>>
+  LockPair(const std::size_t s_id, const std::size_t t_id) {
+    auto first = ShardIndex(s_id);
+    auto second = ShardIndex(t_id);
+    if (first == second) {
+      return {std::unique_lock(_shards[first].mutex),
+              std::unique_lock<std::shared_mutex>()};
+    }
+    if (first > second) {
+      std::swap(first, second);
+    }
+    std::unique_lock first_lock(_shards[first].mutex);
+    std::unique_lock second_lock(_shards[second].mutex);
+    return {std::move(first_lock), std::move(second_lock)};
+  }
+
+  static bool IsLive(const NodeVersion* v) {
+    return v != nullptr && v->node != nullptr;
+  }
+
+  /*!
+   * @brief Free a version chain iteratively
+   * @param head First version to free
+   * @return Number of freed versions
+   */
+  static std::size_t Release(std::unique_ptr<NodeVersion>& head) {
+    std::size_t res{0};
+    for (; head; ++res) {
+      head = std::move(head->prev);
+    }
+    return res;
+  }
+
+  static const EdgePtr* Find(const EdgeRow& row, const std::size_t id) {
+    const auto it = std::ranges::lower_bound(
+        row, id, {}, &std::pair<std::size_t, EdgePtr>::first);
+    return it != row.end() && it->first == id ? &it->second : nullptr;
+  }
+
+  static EdgeRowPtr Inserted(const EdgeRowPtr& row, const std::size_t id,
+                             const EdgePtr& e) {
+    auto res = std::make_shared<EdgeRow>(*row);
+    const auto it = std::ranges::lower_bound(
+        *res, id, {}, &std::pair<std::size_t, EdgePtr>::first);
+    res->emplace(it, id, e);
+    return res;
+  }
+
+  static EdgeRowPtr Erased(const EdgeRowPtr& row, const std::size_t id) {
+    auto res = std::make_shared<EdgeRow>();
+    res->reserve(row->size());
+    for (const auto& entry : *row) {
+      if (entry.first != id) {
+        res->push_back(entry);
+      }
+    }
+    return res;
+  }
+
+  NodeVersion* Head(Shard& shard, const std::size_t id) {
+    const auto it = shard.nodes.find(id);
+    return it == shard.nodes.end() ? nullptr : it->second.head.get();
+  }
+
+  /*!
+   * @brief Newest version of the node not newer than `version`
+   * @param shard Shard of the node (locked)
+   * @param id Node id
+   * @param version Version to read at
+   * @return Node version, nullptr if the node did not exist
+   */
+  static const NodeVersion* Visible(const Shard& shard, const std::size_t id,
+                                    const std::uint64_t version) {
+    const auto it = shard.nodes.find(id);
+    if (it == shard.nodes.end()) {
+      return nullptr;
+    }
+    const auto* v = it->second.head.get();
+    while (v != nullptr && v->version > version) {
+      v = v->prev.get();
+    }
+    return v;
+  }
+
+  /*!
+   * @brief Apply a function to the visible live version of a node
+   * @tparam Func Callable on `const NodeVersion*`
+   * @tparam Res Result type
+   * @param id Node id
+   * @param version Version to read at
+   * @param func Function called under the shard lock
+   * @param missing Result if the node is not visible
+   * @return Result of the function
+   */
+  template <typename Func, typename Res>
+  Res Read(const std::size_t id, const std::uint64_t version, Func&& func,
+           Res missing) const {
+    const auto& shard = ShardOf(id);
+    std::shared_lock lock(shard.mutex);
+    if (const auto* v = Visible(shard, id, version); IsLive(v)) {
+      return func(v);
+    }
+    return missing;
+  }
+
+  EdgePtr FindEdge(const std::size_t s_id, const std::size_t t_id,
+                   const std::uint64_t version) const {
+    return Read(
+        s_id, version,
+        [t_id](const NodeVersion* v) {
+          const auto* e = Find(*v->out, t_id);
+          return e != nullptr ? *e : EdgePtr();
+        },
+        EdgePtr());
+  }
+
+  std::vector<EdgePtr> CopyRow(const std::size_t id,
+                               const std::uint64_t version,
+                               EdgeRowPtr NodeVersion::* row) const {
+    // Only the row pointer is copied under the lock
+    const auto edges = Read(
+        id, version, [row](const NodeVersion* v) { return v->*row; },
+        EdgeRowPtr());
+
+    std::vector<EdgePtr> res;
+    if (edges) {
+      res.reserve(edges->size());
+      for (const auto& [_, e] : *edges) {
+        res.push_back(e);
+      }
+    }
+    return res;
+  }
+
+  std::vector<NodePtr> CollectNodes(const std::uint64_t version) const {
+    std::vector<NodePtr> res;
+    for (std::size_t i = 0; i < _shard_num; ++i) {
+      const auto& shard = _shards[i];
+      std::shared_lock lock(shard.mutex);
+      for (const auto& [id, _] : shard.nodes) {
+        if (const auto* v = Visible(shard, id, version); IsLive(v)) {
+          res.push_back(v->node);
+        }
+      }
+    }
+    return res;
+  }
+
+  static std::vector<NodePtr> Ends(const std::vector<EdgePtr>& edges,
+                                   NodePtr (Edge::*end)() const) {
+    std::vector<NodePtr> res;
+    res.reserve(edges.size());
+    for (const auto& e : edges) {
+      res.push_back(((*e).*end)());
+    }
+    return res;
+  }
+
+  /*!
+   * @brief Version of one modification
+   *
+   * Versions are published in order, so a version handed out must be
+   * published even if its modification throws, or every later writer would
+   * wait for it forever. The destructor publishes a version that was not
+   * committed.
+   */
+  class EpochGuard {
+  public:
+    explicit EpochGuard(ConcurrentDiGraph& graph) : _graph(graph) {}
+
+    EpochGuard(const EpochGuard& other) = delete;
+
+    EpochGuard& operator=(const EpochGuard& other) = delete;
+
+    ~EpochGuard() {
+      if (_version != 0) {
+        _graph.Publish(_version);
+      }
+    }
+
+    /*!
+     * @brief Get a new version (called with the touched shards locked)
+     * @return Version
+     */
+    std::uint64_t Begin() { return _version = ++_graph._next_version; }
+
+    /*!
+     * @brief Publish the version, then reclaim if enough versions retired
+     */
+    void Commit() {
+      _graph.Publish(std::exchange(_version, 0));
+      if (_graph._retired_size.load(std::memory_order_relaxed) >=
+          RECLAIM_THRESHOLD) {
+        _graph._retired_size = 0;
+        _graph.Reclaim();
+      }
+    }
+
+  private:
+    ConcurrentDiGraph& _graph;
+
+    //! @brief Version handed out, 0 if none or committed
+    std::uint64_t _version{0};
+  };
+
+  /*!
+   * @brief Publish a version once all previous ones are published
+   * @param version Version returned by `EpochGuard::Begin`
+   */
+  void Publish(const std::uint64_t version) noexcept {
+    while (_committed.load(std::memory_order_acquire) != version - 1) {
+      std::this_thread::yield();
+    }
+    _committed.store(version, std::memory_order_release);
+  }
+
+  /*!
+   * @brief Push a new version on top of the node's chain
+   */
+  void Install(Shard& shard, NodeRecord& record, const std::size_t id,
+               const std::uint64_t version, NodePtr node, EdgeRowPtr out,
+               EdgeRowPtr in) {
+    const auto retire = record.head != nullptr;
+    record.head = std::make_unique<NodeVersion>(
+        NodeVersion{version, std::move(node), std::move(out), std::move(in),
+                    std::move(record.head)});
+    ++_version_size;
+    if (retire) {
+      shard.retired.push_back(id);
+      shard.retired_size.store(shard.retired.size(),
+                               std::memory_order_relaxed);
+      ++_retired_size;
+    }
+  }
+
+  /*!
+   * @brief Get the version of a live node that belongs to `version`,
+   * copying the current one first if needed
+   */
+  NodeVersion& Writable(Shard& shard, const std::size_t id,
+                        const std::uint64_t version) {
+    auto& record = shard.nodes.at(id);
+    if (record.head->version != version) {
+      const auto& head = *record.head;
+      Install(shard, record, id, version, head.node, head.out, head.in);
+    }
+    return *record.head;
+  }
+
+  /*!
+   * @brief Release a snapshot's pin
+   * @param version Pinned version
+   */
+  void Unpin(const std::uint64_t version) {
+    std::uint64_t bound;
+    {
+      std::lock_guard lock(_pin_mutex);
+      _pinned.erase(_pinned.find(version));
+      bound = _pinned.empty() ? Version() : *_pinned.begin();
+    }
+    // Nothing new to free unless the oldest pin moved
+    if (bound > _reclaimed_bound.load(std::memory_order_relaxed)) {
+      Reclaim();
+    }
+  }
+
+  //! @brief Number of shards
+  std::size_t _shard_num;
+
+  //! @brief Node shards
+  std::unique_ptr<Shard[]> _shards;
+
+  //! @brief Name shards
+  std::unique_ptr<NameShard[]> _name_shards;
+
+  //! @brief Row shared by nodes without edges
+  EdgeRowPtr _empty_row;
+
+  //! @brief Size of nodes
+  std::atomic<std::size_t> _node_size{0};
+
+  //! @brief Size of edges
+  std::atomic<std::size_t> _edge_size{0};
+
+  //! @brief Last version handed out to a writer
+  std::atomic<std::uint64_t> _next_version{0};
+
+  //! @brief Last version visible to snapshots
+  std::atomic<std::uint64_t> _committed{0};
+
+  //! @brief Guards `_pinned`
+  std::mutex _pin_mutex;
+
+  //! @brief Versions (epochs) pinned by live snapshots
+  std::multiset<std::uint64_t> _pinned;
+
+  //! @brief Number of node versions in memory
+  std::atomic<std::size_t> _version_size{0};
+
+  //! @brief Number of versions retired since the last reclamation
+  std::atomic<std::size_t> _retired_size{0};
+
+  //! @brief Highest bound a reclamation has freed up to
+  std::atomic<std::uint64_t> _reclaimed_bound{0};
+
+public:
+  /*!
+   * @brief Immutable view of a `ConcurrentDiGraph` at one version
+   *
+   * Queries take the shard locks only to walk version chains, writers are
+   * never blocked by a snapshot. The graph must outlive its snapshots.
+   */
+  class GraphSnapshot {
+  public:
+    GraphSnapshot(const GraphSnapshot& other) = delete;
+
+    GraphSnapshot(GraphSnapshot&& other) noexcept
+        : _graph(std::exchange(other._graph, nullptr)),
+          _version(other._version) {}
+
+    GraphSnapshot& operator=(const GraphSnapshot& other) = delete;
+
+    GraphSnapshot& operator=(GraphSnapshot&& other) = delete;
+
+    /*!
+     * @brief Destructor, releases the pinned version
+     */
+    ~GraphSnapshot() {
+      if (_graph != nullptr) {
+        _graph->Unpin(_version);
+      }
+    }
+
+    /*!
+     * @brief Get the version the snapshot observes
+     * @return Version
+     */
+    [[nodiscard]] std::uint64_t Version() const { return _version; }
+
+    /*!
+     * @brief Get node ptr according to id
+     * @param id Node id
+     * @return Node ptr if exists else nullptr
+     */
+    NodePtr GetNode(const std::size_t& id) const {
+      return _graph->Read(
+          id, _version, [](const NodeVersion* v) { return v->node; },
+          NodePtr());
+    }
+
+    /*!
+     * @brief Whether there has the node
+     * @param id Node id
+     * @return True if there has the node else false
+     */
+    [[nodiscard]] bool HasNode(const std::size_t& id) const {
+      return GetNode(id) != nullptr;
+    }
+
+    /*!
+     * @brief Get edge ptr
+     * @param s_id Source node id
+     * @param t_id Target node id
+     * @return Edge ptr if exists else nullptr
+     */
+    EdgePtr GetEdge(const std::size_t& s_id, const std::size_t& t_id) const {
+      return _graph->FindEdge(s_id, t_id, _version);
+    }
+
+    /*!
+     * @brief Whether there has the edge
+     * @param s_id Source node id
+     * @param t_id Target node id
+     * @return True if there has the edge else false
+     */
+    [[nodiscard]] bool HasEdge(const std::size_t& s_id,
+                               const std::size_t& t_id) const {
+      return GetEdge(s_id, t_id) != nullptr;
+    }
+
+    /*!
+     * @brief Get copy of all nodes
+     * @return Nodes
+     */
+    std::vector<NodePtr> Nodes() const {
+      return _graph->CollectNodes(_version);
+    }
+
+    /*!
+     * @brief Get size of nodes (O(V))
+     * @return Size of nodes
+     */
+    [[nodiscard]] std::size_t NodeSize() const { return Nodes().size(); }
+
+    /*!
+     * @brief Get size of edges (O(V))
+     * @return Size of edges
+     */
+    [[nodiscard]] std::size_t EdgeSize() const {
+      std::size_t res{0};
+      for (const auto& n : Nodes()) {
+        res += _graph->Read(
+            n->Id(), _version,
+            [](const NodeVersion* v) { return v->out->size(); },
+            std::size_t{0});
+      }
+      return res;
+    }
+
+    /*!
+     * @brief Get in edges from the node
+     * @param id Node id
+     * @return In edges
+     */
+    std::vector<EdgePtr> InEdges(const std::size_t& id) const {
+      return _graph->CopyRow(id, _version, &NodeVersion::in);
+    }
+
+    /*!
+     * @brief Get out edges from the node
+     * @param id Node id
+     * @return Out edges
+     */
+    std::vector<EdgePtr> OutEdges(const std::size_t& id) const {
+      return _graph->CopyRow(id, _version, &NodeVersion::out);
+    }
+
+    /*!
+     * @brief Get all parents nodes ptr from the node
+     * @param id Node id
+     * @return Parents nodes
+     */
+    std::vector<NodePtr> Parents(const std::size_t& id) const {
+      return Ends(InEdges(id), &Edge::Source);
+    }
+
+    /*!
+     * @brief Get all children nodes ptr from the node
+     * @param id Node id
+     * @return Children nodes
+     */
+    std::vector<NodePtr> Children(const std::size_t& id) const {
+      return Ends(OutEdges(id), &Edge::Target);
+    }
+
+  private:
+    friend class ConcurrentDiGraph;
+
+    GraphSnapshot(ConcurrentDiGraph* graph, const std::uint64_t version)
+        : _graph(graph), _version(version) {}
+
+    //! @brief Observed graph
+    ConcurrentDiGraph* _graph;
+
+    //! @brief Observed version
+    std::uint64_t _version;
+  };
+};
+
+} // namespace xgraph
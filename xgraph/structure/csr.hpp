@@ -0,0 +1,424 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+
+namespace xgraph {
+
+/*!
+ * @brief Read-only compressed sparse row snapshot of a graph
+ *
+ * Nodes are renumbered to dense indices in `[0, NodeSize())` and every row
+ * of neighbors is sorted by index. Undirected graphs store each edge in both
+ * directions. The snapshot does not observe later changes of the source
+ * graph, compare `Version()` with the graph's one to detect staleness.
+ *
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node = XNode<>, EdgeType Edge = XEdge<>> class CSRGraph {
+  using NodePtr = std::shared_ptr<Node>;
+  using EdgePtr = std::shared_ptr<Edge>;
+
+public:
+  //! @brief Type of stored weights (nothing is stored for unweighted edges)
+  using WeightType = EdgeWeightArg_t<Edge>;
+
+  //! @brief Index returned for nodes that are not in the snapshot
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /*!
+   * @brief Default constructor (empty snapshot)
+   */
+  CSRGraph() = default;
+
+  /*!
+   * @brief Build snapshot from a graph
+   * @param graph Source graph
+   * @throw std::invalid_argument if an edge has an endpoint that is not a
+   * node of the graph
+   */
+  explicit CSRGraph(const DiGraph<Node, Edge>& graph)
+      : _directed(graph.IsDirected()), _version(graph.Version()) {
+    // Dense indices follow node id order to keep the layout deterministic
+    for (const auto& n : graph.Nodes()) {
+      _nodes.push_back(n);
+    }
+    std::ranges::sort(_nodes, {}, [](const NodePtr& n) { return n->Id(); });
+
+    _index.reserve(_nodes.size());
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+      _index.emplace(_nodes[i]->Id(), i);
+    }
+
+    // Collect arcs
+    std::vector<Arc> arcs;
+    for (const auto& e : graph.Edges()) {
+      const auto s = Index(e->Source()->Id());
+      const auto t = Index(e->Target()->Id());
+      if (s == npos || t == npos) {
+        throw std::invalid_argument("Edge endpoint is not a node of the graph");
+      }
+      arcs.push_back({s, t, e});
+      if (!_directed && s != t) {
+        arcs.push_back({t, s, e});
+      }
+    }
+    Fill(std::move(arcs));
+  }
+
+  /*!
+   * @brief Copy of the snapshot with renumbered dense indices
+   * @param permutation New dense index of every current dense index
+   * @return Snapshot where node `i` of this one has index `permutation[i]`
+   */
+  [[nodiscard]] CSRGraph
+  Permute(std::span<const std::size_t> permutation) const {
+    CSRGraph res;
+    res._directed = _directed;
+    res._version = _version;
+    res._nodes.resize(_nodes.size());
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+      res._nodes[permutation[i]] = _nodes[i];
+    }
+    res._index.reserve(_index.size());
+    for (const auto& [id, index] : _index) {
+      res._index.emplace(id, permutation[index]);
+    }
+
+    std::vector<Arc> arcs;
+    arcs.reserve(_out_targets.size());
+    for (std::size_t s = 0; s < _nodes.size(); ++s) {
+      for (auto pos = _out_offsets[s]; pos < _out_offsets[s + 1]; ++pos) {
+        arcs.push_back({permutation[s], permutation[_out_targets[pos]],
+                        _out_edges[pos]});
+      }
+    }
+    res.Fill(std::move(arcs));
+    return res;
+  }
+
+  /*!
+   * @brief Induced subgraph on some nodes, sharing node and edge pointers
+   * @param indices Dense indices of kept nodes, strictly increasing
+   * @return Snapshot where `indices[i]` of this one has index `i`
+   */
+  [[nodiscard]] CSRGraph
+  Subgraph(std::span<const std::size_t> indices) const {
+    CSRGraph res;
+    res._directed = _directed;
+    res._version = _version;
+    std::vector<std::size_t> renumber(_nodes.size(), npos);
+    res._nodes.reserve(indices.size());
+    res._index.reserve(indices.size());
+    for (const auto i : indices) {
+      renumber[i] = res._nodes.size();
+      res._index.emplace(_nodes[i]->Id(), res._nodes.size());
+      res._nodes.push_back(_nodes[i]);
+    }
+
+    std::vector<Arc> arcs;
+    for (const auto s : indices) {
+      for (auto pos = _out_offsets[s]; pos < _out_offsets[s + 1]; ++pos) {
+        if (renumber[_out_targets[pos]] != npos) {
+          arcs.push_back(
+              {renumber[s], renumber[_out_targets[pos]], _out_edges[pos]});
+        }
+      }
+    }
+    res.Fill(std::move(arcs));
+    return res;
+  }
+
+  /*!
+   * @brief Whether the source graph is directed
+   * @return Boolean
+   */
+  [[nodiscard]] bool IsDirected() const { return _directed; }
+
+  /*!
+   * @brief Version of the source graph when the snapshot was built
+   * @return Version
+   */
+  [[nodiscard]] std::size_t Version() const { return _version; }
+
+  /*!
+   * @brief Get size of nodes
+   * @return Size of nodes
+   */
+  [[nodiscard]] std::size_t NodeSize() const { return _nodes.size(); }
+
+  /*!
+   * @brief Get size of stored arcs (twice the edges for undirected graphs)
+   * @return Size of arcs
+   */
+  [[nodiscard]] std::size_t EdgeSize() const { return _out_targets.size(); }
+
+  /*!
+   * @brief Get dense index of node id
+   * @param id Node id
+   * @return Dense index if exists else `npos`
+   */
+  [[nodiscard]] std::size_t Index(const std::size_t& id) const {
+    if (const auto it = _index.find(id); it != _index.end()) {
+      return it->second;
+    }
+    return npos;
+  }
+
+  /*!
+   * @brief Get dense index of node ptr
+   * @param n Node ptr
+   * @return Dense index if exists else `npos`
+   */
+  [[nodiscard]] std::size_t Index(const NodePtr& n) const {
+    return Index(n->Id());
+  }
+
+  /*!
+   * @brief Get node ptr of dense index
+   * @param index Dense index
+   * @return Node ptr
+   */
+  const NodePtr& GetNode(const std::size_t index) const {
+    return _nodes[index];
+  }
+
+  /*!
+   * @brief Get out neighbors of the node (sorted)
+   * @param index Dense index
+   * @return Dense indices of out neighbors
+   */
+  [[nodiscard]] std::span<const std::size_t>
+  OutNeighbors(const std::size_t index) const {
+    return Row(_out_targets, _out_offsets, index);
+  }
+
+  /*!
+   * @brief Get weights of out edges, aligned with `OutNeighbors`
+   * @param index Dense index
+   * @return Weights
+   */
+  [[nodiscard]] std::span<const WeightType>
+  OutWeights(const std::size_t index) const
+    requires(!IsUnweighted_v<Edge>)
+  {
+    return Row(_out_weights, _out_offsets, index);
+  }
+
+  /*!
+   * @brief Get out edges ptr, aligned with `OutNeighbors`
+   * @param index Dense index
+   * @return Edges ptr
+   */
+  std::span<const EdgePtr> OutEdges(const std::size_t index) const {
+    return Row(_out_edges, _out_offsets, index);
+  }
+
+  /*!
+   * @brief Get in neighbors of the node (sorted)
+   * @param index Dense index
+   * @return Dense indices of in neighbors
+   */
+  [[nodiscard]] std::span<const std::size_t>
+  InNeighbors(const std::size_t index) const {
+    return Row(_in_sources, _in_offsets, index);
+  }
+
+  /*!
+   * @brief Get out degree of the node
+   * @param index Dense index
+   * @return Out degree
+   */
+  [[nodiscard]] std::size_t OutDegree(const std::size_t index) const {
+    return _out_offsets[index + 1] - _out_offsets[index];
+  }
+
+  /*!
+   * @brief Get in degree of the node
+   * @param index Dense index
+   * @return In degree
+   */
+  [[nodiscard]] std::size_t InDegree(const std::size_t index) const {
+    return _in_offsets[index + 1] - _in_offsets[index];
+  }
+
+  /*!
+   * @brief Find the arc between two nodes by binary search in the out row
+   * @param source Dense index of source
+   * @param target Dense index of target
+   * @return Arc position (usable with `EdgeColumn`) if exists else `npos`
+   */
+  [[nodiscard]] std::size_t FindArc(const std::size_t source,
+                                    const std::size_t target) const {
+    const auto row = OutNeighbors(source);
+    if (const auto it = std::ranges::lower_bound(row, target);
+        it != row.end() && *it == target) {
+      return _out_offsets[source] + static_cast<std::size_t>(it - row.begin());
+    }
+    return npos;
+  }
+
+  /*!
+   * @brief Get position of the first out arc of the node, arcs of the node
+   * are `[OutOffset(index), OutOffset(index) + OutDegree(index))`
+   * @param index Dense index
+   * @return Arc position
+   */
+  [[nodiscard]] std::size_t OutOffset(const std::size_t index) const {
+    return _out_offsets[index];
+  }
+
+  /*!
+   * @brief Extract a node attribute into a column (struct of arrays)
+   * @tparam Proj Callable on `const Node&`
+   * @param proj Projection of the attribute
+   * @return Column indexed by dense index
+   */
+  template <typename Proj> auto NodeColumn(Proj&& proj) const {
+    std::vector<
+        std::remove_cvref_t<std::invoke_result_t<Proj&, const Node&>>>
+        res;
+    res.reserve(_nodes.size());
+    for (const auto& n : _nodes) {
+      res.push_back(std::invoke(proj, std::as_const(*n)));
+    }
+    return res;
+  }
+
+  /*!
+   * @brief Extract an edge attribute into a column (struct of arrays)
+   * @note Undirected edges are stored as two arcs, so their value appears
+   * twice
+   * @tparam Proj Callable on `const Edge&`
+   * @param proj Projection of the attribute
+   * @return Column indexed by arc position
+   */
+  template <typename Proj> auto EdgeColumn(Proj&& proj) const {
+    std::vector<
+        std::remove_cvref_t<std::invoke_result_t<Proj&, const Edge&>>>
+        res;
+    res.reserve(_out_edges.size());
+    for (const auto& e : _out_edges) {
+      res.push_back(std::invoke(proj, std::as_const(*e)));
+    }
+    return res;
+  }
+
+  /*!
+   * @brief Get values of the out arcs of the node from an edge column,
+   * aligned with `OutNeighbors`
+   * @tparam T Value type
+   * @param column Column returned by `EdgeColumn`
+   * @param index Dense index
+   * @return Values
+   */
+  template <typename T>
+  std::span<const T> OutRow(const std::vector<T>& column,
+                            const std::size_t index) const {
+    return Row(column, _out_offsets, index);
+  }
+
+private:
+  //! @brief Arc between two dense indices
+  struct Arc {
+    std::size_t source;
+    std::size_t target;
+    EdgePtr edge;
+  };
+
+  /*!
+   * @brief Build out and in rows from arcs
+   * @param arcs Arcs (in any order)
+   */
+  void Fill(std::vector<Arc> arcs) {
+    std::ranges::sort(arcs, [](const Arc& lhs, const Arc& rhs) {
+      return lhs.source != rhs.source ? lhs.source < rhs.source
+                                      : lhs.target < rhs.target;
+    });
+
+    // Out rows
+    _out_offsets.assign(_nodes.size() + 1, 0);
+    _out_targets.reserve(arcs.size());
+    _out_edges.reserve(arcs.size());
+    for (const auto& [s, t, e] : arcs) {
+      ++_out_offsets[s + 1];
+      _out_targets.push_back(t);
+      _out_edges.push_back(e);
+    }
+    if constexpr (!IsUnweighted_v<Edge>) {
+      _out_weights.reserve(arcs.size());
+      for (const auto& arc : arcs) {
+        _out_weights.push_back(arc.edge->Weight());
+      }
+    }
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+      _out_offsets[i + 1] += _out_offsets[i];
+    }
+
+    // In rows (counting sort keeps sources ordered inside each row)
+    _in_offsets.assign(_nodes.size() + 1, 0);
+    for (const auto t : _out_targets) {
+      ++_in_offsets[t + 1];
+    }
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+      _in_offsets[i + 1] += _in_offsets[i];
+    }
+    _in_sources.resize(_out_targets.size());
+    auto cursor = _in_offsets;
+    for (std::size_t s = 0; s < _nodes.size(); ++s) {
+      for (const auto t : OutNeighbors(s)) {
+        _in_sources[cursor[t]++] = s;
+      }
+    }
+  }
+
+  template <typename T>
+  static std::span<const T> Row(const std::vector<T>& data,
+                                const std::vector<std::size_t>& offsets,
+                                const std::size_t index) {
+    return {data.data() + offsets[index], offsets[index + 1] - offsets[index]};
+  }
+
+  //! @brief Whether the source graph is directed
+  bool _directed{true};
+
+  //! @brief Version of the source graph
+  std::size_t _version{0};
+
+  //! @brief Nodes ordered by dense index
+  std::vector<NodePtr> _nodes;
+
+  //! @brief Node id to dense index
+  std::unordered_map<std::size_t, std::size_t> _index;
+
+  //! @brief Out row offsets
+  std::vector<std::size_t> _out_offsets;
+
+  //! @brief Out row targets
+  std::vector<std::size_t> _out_targets;
+
+  //! @brief Out row weights (in the edge's own type)
+  std::vector<WeightType> _out_weights;
+
+  //! @brief Out row edges
+  std::vector<EdgePtr> _out_edges;
+
+  //! @brief In row offsets
+  std::vector<std::size_t> _in_offsets;
+
+  //! @brief In row sources
+  std::vector<std::size_t> _in_sources;
+};
+
+} // namespace xgraph
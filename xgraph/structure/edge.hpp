@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <type_traits>
 
 #include "node.hpp"
 #include "type_concepts.hpp"
@@ -11,19 +12,35 @@ namespace xgraph {
  * @brief Default edge class
  * @tparam Node Use `XNode` by default
  * @tparam EdgeData Edge data
+ * @tparam EdgeWeight Arithmetic weight type, `void` for unweighted edges
+ * (every weight is 1 and nothing is stored)
  */
-template <NodeType Node = XNode<>, UserDataType EdgeData = EmptyObject>
+template <NodeType Node = XNode<>, UserDataType EdgeData = EmptyObject,
+          typename EdgeWeight = double>
+  requires(std::is_void_v<EdgeWeight> || std::is_arithmetic_v<EdgeWeight>)
 class XEdge {
+  //! @brief Type of weight arguments (ignored by unweighted edges)
+  using WeightArg =
+      std::conditional_t<std::is_void_v<EdgeWeight>, double, EdgeWeight>;
+
+  //! @brief Type returned by `Weight()`
+  using WeightValue =
+      std::conditional_t<std::is_void_v<EdgeWeight>, int, EdgeWeight>;
+
 public:
+  //! @brief Weight type, `void` for unweighted edges
+  using WeightType = EdgeWeight;
+
   /*!
    * @brief Explicit constructor of `XEdge`
    * @param source Source node pointer
    * @param target Target node pointer
-   * @param weight Edge weight (1.0 by default)
+   * @param weight Edge weight (1 by default)
    */
   XEdge(const std::weak_ptr<Node>& source, const std::weak_ptr<Node>& target,
-        const double weight = 1.0)
-      : _source(source), _target(target), _weight(weight), _edge_data() {
+        const WeightArg weight = WeightArg{1})
+      : _source(source), _target(target), _weight(StoredWeight(weight)),
+        _edge_data() {
     // Nothing to do here.
   }
 
@@ -35,9 +52,9 @@ public:
    * @param user_data User edge data (copy constructible)
    */
   XEdge(const std::weak_ptr<Node>& source, const std::weak_ptr<Node>& target,
-        const double weight, const EdgeData& user_data)
+        const WeightArg weight, const EdgeData& user_data)
     requires std::is_copy_constructible_v<EdgeData>
-      : _source(source), _target(target), _weight(weight),
+      : _source(source), _target(target), _weight(StoredWeight(weight)),
         _edge_data(user_data) {
     // Nothing to do here.
   }
@@ -50,9 +67,9 @@ public:
    * @param user_data User edge data (move constructible)
    */
   XEdge(const std::weak_ptr<Node>& source, const std::weak_ptr<Node>& target,
-        const double weight, EdgeData&& user_data)
+        const WeightArg weight, EdgeData&& user_data)
     requires std::is_move_constructible_v<EdgeData>
-      : _source(source), _target(target), _weight(weight),
+      : _source(source), _target(target), _weight(StoredWeight(weight)),
         _edge_data(std::move(user_data)) {
     // Nothing to do here.
   }
@@ -93,15 +110,21 @@ public:
 
   /*!
    * @brief Get const edge weight
-   * @return Edge weight
+   * @return Edge weight (1 for unweighted edges)
    */
-  [[nodiscard]] double Weight() const { return _weight; }
+  [[nodiscard]] WeightValue Weight() const {
+    if constexpr (std::is_void_v<EdgeWeight>) {
+      return 1;
+    } else {
+      return _weight;
+    }
+  }
 
   /*!
-   * @brief Get const edge data
+   * @brief Get const reference to edge data
    * @return Edge data
    */
-  EdgeData Data() const { return _edge_data; }
+  const EdgeData& Data() const { return _edge_data; }
 
   /*!
    * @brief Get reference to edge data
@@ -116,18 +139,28 @@ public:
    */
   bool operator==(const XEdge& other) const {
     return *_source.lock() == *other.Source() &&
-           *_target.lock() == *other.Target() && _weight == other.Weight();
+           *_target.lock() == *other.Target() && Weight() == other.Weight();
   }
 
 private:
+  static auto StoredWeight([[maybe_unused]] const WeightArg weight) {
+    if constexpr (std::is_void_v<EdgeWeight>) {
+      return EmptyObject{};
+    } else {
+      return weight;
+    }
+  }
+
   //! @brief Source node without ownership
   const std::weak_ptr<Node> _source;
 
   //! @brief Target node without ownership
   const std::weak_ptr<Node> _target;
 
-  //! @brief Weight of the edge
-  double _weight;
+  //! @brief Weight of the edge (empty if unweighted)
+  [[no_unique_address]] std::conditional_t<std::is_void_v<EdgeWeight>,
+                                           EmptyObject, EdgeWeight>
+      _weight;
 
   //! @brief Edge data
   EdgeData _edge_data;
@@ -1,19 +1,47 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <queue>
+#include <ranges>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "edge.hpp"
+#include "lru_cache.hpp"
+#include "mutation_batch.hpp"
 #include "node.hpp"
 #include "type_traits.hpp"
 #include "utils.hpp"
 
 namespace xgraph {
 
+/*!
+ * @brief Occupancy of the dense node slots of a graph
+ */
+struct SlotStats {
+  //! @brief Size of slots including removed ones
+  std::size_t slots{0};
+
+  //! @brief Size of removed slots not reclaimed yet
+  std::size_t tombstones{0};
+
+  /*!
+   * @brief Get ratio of removed slots
+   * @return Ratio in `[0, 1]`
+   */
+  [[nodiscard]] double Ratio() const {
+    return slots == 0 ? 0.0 : static_cast<double>(tombstones) / slots;
+  }
+};
+
 /*!
  * Forward declaration
  */
@@ -28,8 +56,12 @@ template <NodeType Node = XNode<>, EdgeType Edge = XEdge<>> class DiGraph {
   using NodePtr = std::shared_ptr<Node>;
   using EdgePtr = std::shared_ptr<Edge>;
   using NodeAdj = std::unordered_map<std::size_t, std::weak_ptr<Edge>>;
+  using WeightArg = EdgeWeightArg_t<Edge>;
 
 public:
+  //! @brief Slot returned for nodes that are not in the graph
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
   /*!
    * @brief Default constructor
    */
@@ -62,7 +94,7 @@ public:
         _adjacent(), _node_name() {
     // Copy nodes
     for (const auto& n : other.Nodes()) {
-      AddNode(n->Id(), n->Name(), n->Data());
+      AddNode(n->Id(), std::string(n->Name()), n->Data());
     }
 
     // Copy edges
@@ -83,7 +115,7 @@ public:
         _adjacent(), _node_name() {
     // Copy nodes
     for (const auto& n : other.Nodes()) {
-      AddNode(n->Id(), n->Name(), n->Data());
+      AddNode(n->Id(), std::string(n->Name()), n->Data());
     }
 
     // Copy edges
@@ -101,7 +133,7 @@ public:
         _edges(1, utils::DiEdgePtrHash<Edge>, utils::DiEdgePtrEqual<Edge>),
         _adjacent(), _node_name() {
     for (const auto& n : other.Nodes()) {
-      AddNode(n->Id(), n->Name(), n->Data());
+      AddNode(n->Id(), std::string(n->Name()), n->Data());
     }
 
     for (const auto& e : other.Edges()) {
@@ -119,7 +151,7 @@ public:
         _edges(1, utils::DiEdgePtrHash<Edge>, utils::DiEdgePtrEqual<Edge>),
         _adjacent(), _node_name() {
     for (const auto& n : other.Nodes()) {
-      AddNode(n->Id(), n->Name(), n->Data());
+      AddNode(n->Id(), std::string(n->Name()), n->Data());
     }
 
     for (const auto& e : other.Edges()) {
@@ -148,6 +180,37 @@ public:
    */
   [[nodiscard]] virtual bool IsDirected() const { return true; }
 
+  /*!
+   * @brief Get modification counter, bumped by every effective change of
+   * nodes or edges
+   * @return Version
+   */
+  [[nodiscard]] std::size_t Version() const { return _version; }
+
+  /*!
+   * @brief Cache results of `Parents`, `Children`, `Predecessor` and
+   * `Successor`, the cache is dropped whenever `Version()` changes
+   * @note Queries mutate the cache, so concurrent readers are not allowed
+   * while it is enabled
+   * @param capacity Max number of cached results
+   */
+  void EnableQueryCache(const std::size_t capacity) {
+    _query_cache = std::make_unique<QueryCache>(capacity);
+  }
+
+  /*!
+   * @brief Drop the query cache and stop caching
+   */
+  void DisableQueryCache() { _query_cache.reset(); }
+
+  /*!
+   * @brief Get counters of the query cache
+   * @return Counters (all zero if the cache is disabled)
+   */
+  [[nodiscard]] utils::CacheStats QueryCacheStats() const {
+    return _query_cache ? _query_cache->Stats() : utils::CacheStats{};
+  }
+
   /*!
    * @brief Add node ptr (no effect if exists already)
    * @param n Node ptr
@@ -156,8 +219,16 @@ public:
     const auto& [node_it, inserted] = _nodes.insert(n);
 
     if (inserted) {
-      // Ensure the validity of the weak pointer.
-      _node_name[(*node_it)->Name()] = std::weak_ptr<Node>(*node_it);
+      // Re-insert so that the key views the name of the stored node
+      if (const auto name_it = _node_name.find((*node_it)->Name());
+          name_it != _node_name.end()) {
+        _node_name.erase(name_it);
+      }
+      _node_name.emplace(NodeNameKey_t<Node>((*node_it)->Name()),
+                         std::weak_ptr<Node>(*node_it));
+      _slot_of.emplace((*node_it)->Id(), _slots.size());
+      _slots.push_back(*node_it);
+      ++_version;
     }
   }
 
@@ -177,8 +248,24 @@ public:
    * @param n Node need to remove
    */
   virtual void RemoveNode(const NodePtr& n) {
-    _node_name.erase(n->Name());
-    _nodes.erase(n);
+    if (const auto node_it = _nodes.find(n); node_it != _nodes.end()) {
+      // The name may have been taken over by another node
+      if (const auto name_it = _node_name.find((*node_it)->Name());
+          name_it != _node_name.end() && name_it->second.lock() == *node_it) {
+        _node_name.erase(name_it);
+      }
+
+      // Tombstone the slot, `Compact` reclaims it
+      const auto id = (*node_it)->Id();
+      _slots[_slot_of.at(id)] = nullptr;
+      _slot_of.erase(id);
+      ++_tombstones;
+      EraseEmptyRow(_adjacent, id);
+      EraseEmptyRow(_in_adjacent, id);
+
+      _nodes.erase(node_it);
+      ++_version;
+    }
   }
 
   /*!
@@ -187,13 +274,40 @@ public:
    * @param n Node
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
   void RemoveNode(T&& n) {
     if (const auto node_ptr = GetNode(std::forward<T>(n));
         node_ptr != nullptr) {
-      // Remove edges
-      for (const auto& e : Edges(std::forward<T>(n))) {
+      // Remove edges, the linked one of every entry before the parallel
+      // ones, each being linked in turn
+      const auto id = node_ptr->Id();
+      std::vector<EdgePtr> edges;
+      const auto collect = [this, &edges](const std::size_t s_id,
+                                          const std::size_t t_id,
+                                          const std::weak_ptr<Edge>& linked) {
+        edges.push_back(linked.lock());
+        if (const auto bucket = _parallel.find({s_id, t_id});
+            bucket != _parallel.end()) {
+          for (const auto& other : bucket->second | std::views::reverse) {
+            edges.push_back(other.lock());
+          }
+        }
+      };
+      if (const auto row = _adjacent.find(id); row != _adjacent.end()) {
+        for (const auto& [t_id, e] : row->second) {
+          collect(id, t_id, e);
+        }
+      }
+      if (const auto row = _in_adjacent.find(id); row != _in_adjacent.end()) {
+        for (const auto& [s_id, e] : row->second) {
+          // Self loops are in the out row already
+          if (s_id != id) {
+            collect(s_id, id, e);
+          }
+        }
+      }
+      for (const auto& e : edges) {
         RemoveEdge(e);
       }
 
@@ -211,8 +325,8 @@ public:
 
     if (inserted) {
       // Ensure the validity of the weak pointer.
-      _adjacent[(*edge_it)->Source()->Id()][(*edge_it)->Target()->Id()] =
-          std::weak_ptr<Edge>(*edge_it);
+      Link(*edge_it);
+      ++_version;
     }
   }
 
@@ -241,7 +355,7 @@ public:
    * @param args Auxiliary arguments to construct edge
    */
   template <typename... Args>
-  void AddEdge(const std::string& s_name, const std::string& t_name,
+  void AddEdge(const std::string_view s_name, const std::string_view t_name,
                Args&&... args) {
     const auto& s_node_ptr = GetNode(s_name);
     const auto& t_node_ptr = GetNode(t_name);
@@ -255,8 +369,11 @@ public:
    * @param e Edge need to remove
    */
   virtual void RemoveEdge(const EdgePtr& e) {
-    _adjacent.erase(e->Source()->Id());
-    _edges.erase(e);
+    if (const auto edge_it = _edges.find(e); edge_it != _edges.end()) {
+      Unlink(*edge_it);
+      _edges.erase(edge_it);
+      ++_version;
+    }
   }
 
   /*!
@@ -264,12 +381,13 @@ public:
    * @tparam T Argument type that can convert to call `GetEdge`
    * @param s Source
    * @param t Target
-   * @param w Weight
+   * @param w Weight (`std::nullopt` matches any weight)
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
-  void RemoveEdge(T&& s, T&& t, const double w = 1.0) {
+  void RemoveEdge(T&& s, T&& t,
+                  const std::optional<WeightArg> w = WeightArg{1}) {
     if (const auto edge_ptr =
             GetEdge(std::forward<T>(s), std::forward<T>(t), w);
         edge_ptr != nullptr) {
@@ -277,15 +395,80 @@ public:
     }
   }
 
+  /*!
+   * @brief Apply buffered mutations in one pass grouped by source node
+   * @note The whole batch counts as one change of `Version()`, mutations
+   * referring to missing nodes are ignored
+   * @param batch Mutations (cleared afterwards)
+   * @return Number of effective mutations
+   */
+  std::size_t Apply(MutationBatch<Node, Edge>& batch) {
+    using Kind = typename MutationBatch<Node, Edge>::Kind;
+
+    std::size_t changed{0};
+    NodePtr source;
+    NodeAdj* row = nullptr;
+    for (const auto& m : batch.Normalize(IsDirected())) {
+      // Source node and its row are looked up once per group
+      if (!source || source->Id() != m.source) {
+        source = GetNode(m.source);
+        const auto row_it = _adjacent.find(m.source);
+        row = row_it != _adjacent.end() ? &row_it->second : nullptr;
+      }
+      const auto target = GetNode(m.target);
+      if (!source || !target) {
+        continue;
+      }
+
+      if (m.kind == Kind::Add) {
+        const auto& [edge_it, inserted] = _edges.insert(
+            m.edge ? m.edge
+                   : std::make_shared<Edge>(std::weak_ptr<Node>(source),
+                                            std::weak_ptr<Node>(target),
+                                            m.weight));
+        if (inserted) {
+          Link(*edge_it);
+          if (row == nullptr) {
+            row = &_adjacent[m.source];
+          }
+          ++changed;
+        }
+        continue;
+      }
+
+      // Probe the adjacency first, other weights need a lookup in `_edges`
+      EdgePtr probe;
+      if (row != nullptr) {
+        if (const auto entry = row->find(m.target); entry != row->end()) {
+          probe = entry->second.lock();
+        }
+      }
+      if (!probe || (!IsUnweighted_v<Edge> && probe->Weight() != m.weight)) {
+        probe = std::make_shared<Edge>(std::weak_ptr<Node>(source),
+                                       std::weak_ptr<Node>(target), m.weight);
+      }
+      if (const auto edge_it = _edges.find(probe); edge_it != _edges.end()) {
+        Unlink(*edge_it);
+        _edges.erase(edge_it);
+        ++changed;
+      }
+    }
+
+    if (changed != 0) {
+      ++_version;
+    }
+    batch.Clear();
+    return changed;
+  }
+
   /*!
    * @brief Get node ptr according to id
    * @param id Node id
    * @return Node ptr if exists else nullptr
    */
   virtual NodePtr GetNode(const std::size_t& id) const {
-    if (const auto& res = _nodes.find(std::make_shared<Node>(id));
-        res != _nodes.end()) {
-      return *res;
+    if (const auto res = _slot_of.find(id); res != _slot_of.end()) {
+      return _slots[res->second];
     }
     return nullptr;
   }
@@ -295,7 +478,7 @@ public:
    * @param name Node name
    * @return Node ptr if exists else nullptr
    */
-  virtual NodePtr GetNode(const std::string& name) const {
+  virtual NodePtr GetNode(const std::string_view name) const {
     if (const auto& res = _node_name.find(name); res != _node_name.end()) {
       return res->second.lock();
     }
@@ -309,7 +492,7 @@ public:
    * @return True if there has the node else false
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
   [[nodiscard]] bool HasNode(T&& arg) const {
     return GetNode(std::forward<T>(arg)) != nullptr;
@@ -328,7 +511,61 @@ public:
    * @brief Get size of nodes
    * @return Size of nodes
    */
-  [[nodiscard]] virtual std::size_t NodeSize() const { return Nodes().size(); }
+  [[nodiscard]] virtual std::size_t NodeSize() const { return _nodes.size(); }
+
+  /*!
+   * @brief Get dense slot of node, slots stay stable until `Compact`
+   * @param id Node id
+   * @return Slot if exists else `npos`
+   */
+  [[nodiscard]] std::size_t Slot(const std::size_t& id) const {
+    if (const auto res = _slot_of.find(id); res != _slot_of.end()) {
+      return res->second;
+    }
+    return npos;
+  }
+
+  /*!
+   * @brief Get node ptr of dense slot
+   * @param slot Slot in `[0, SlotSize())`
+   * @return Node ptr, nullptr if the node was removed
+   */
+  const NodePtr& NodeAt(const std::size_t slot) const { return _slots[slot]; }
+
+  /*!
+   * @brief Get size of slots including removed ones
+   * @return Size of slots
+   */
+  [[nodiscard]] std::size_t SlotSize() const { return _slots.size(); }
+
+  /*!
+   * @brief Get occupancy of dense slots
+   * @return Counters
+   */
+  [[nodiscard]] SlotStats Fragmentation() const {
+    return {_slots.size(), _tombstones};
+  }
+
+  /*!
+   * @brief Reclaim removed slots and renumber the others, keeping their order
+   * @note Invalidates slots obtained before
+   * @return Size of reclaimed slots
+   */
+  std::size_t Compact() {
+    std::size_t size{0};
+    for (auto& n : _slots) {
+      if (n) {
+        _slot_of[n->Id()] = size;
+        _slots[size++] = std::move(n);
+      }
+    }
+    _slots.resize(size);
+    _slots.shrink_to_fit();
+
+    const auto reclaimed = _tombstones;
+    _tombstones = 0;
+    return reclaimed;
+  }
 
   /*!
    * @brief Get edge ptr
@@ -344,21 +581,40 @@ public:
 
   /*!
    * @brief Get edge ptr
+   * @note Answered from the adjacency rows without allocation, unless another
+   * edge with a different weight links the same nodes
    * @tparam T Argument type that can convert to call `GetNode`
    * @param s Source node
    * @param t Target node
-   * @param w Weight
+   * @param w Weight (`std::nullopt` matches any weight)
    * @return Edge ptr if exists else nullptr
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
-  EdgePtr GetEdge(T&& s, T&& t, const double w = 1.0) const {
-    const auto s_node_ptr = GetNode(std::forward<T>(s));
-    const auto t_node_ptr = GetNode(std::forward<T>(t));
-    if (s_node_ptr && t_node_ptr) {
-      return GetEdge(std::make_shared<Edge>(
-          std::weak_ptr<Node>(s_node_ptr), std::weak_ptr<Node>(t_node_ptr), w));
+  EdgePtr GetEdge(T&& s, T&& t,
+                  const std::optional<WeightArg> w = WeightArg{1}) const {
+    const auto s_id = NodeId(std::forward<T>(s));
+    const auto t_id = NodeId(std::forward<T>(t));
+    if (!s_id || !t_id) {
+      return nullptr;
+    }
+
+    bool linked{false};
+    if (auto e = FindLinked(*s_id, *t_id, w, linked)) {
+      return e;
+    }
+    if (!IsDirected()) {
+      if (auto e = FindLinked(*t_id, *s_id, w, linked)) {
+        return e;
+      }
+    }
+
+    // One edge between two nodes is linked in the rows, others are probed
+    if (linked && w) {
+      return GetEdge(std::make_shared<Edge>(std::weak_ptr<Node>(GetNode(*s_id)),
+                                            std::weak_ptr<Node>(GetNode(*t_id)),
+                                            *w));
     }
     return nullptr;
   }
@@ -368,13 +624,14 @@ public:
    * @tparam T Argument type that can convert to call `GetEdge`
    * @param s Source node
    * @param t Target node
-   * @param w Weight
+   * @param w Weight (`std::nullopt` matches any weight)
    * @return True if there has the edge else false
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
-  [[nodiscard]] bool HasEdge(T&& s, T&& t, const double w = 1.0) const {
+  [[nodiscard]] bool
+  HasEdge(T&& s, T&& t, const std::optional<WeightArg> w = WeightArg{1}) const {
     return GetEdge(std::forward<T>(s), std::forward<T>(t), w) != nullptr;
   }
 
@@ -394,7 +651,7 @@ public:
    * @return Edges
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
   auto Edges(T&& n) const {
     auto res = DiGraph<Node, Edge>::InEdges(std::forward<T>(n));
@@ -415,10 +672,10 @@ public:
     decltype(_edges) res(1, _edges.hash_function(), _edges.key_eq());
 
     if (const auto node = GetNode(id)) {
-      for (const auto& i : _adjacent) {
-        if (const auto& n_parent = i.second.find(node->Id());
-            n_parent != i.second.end()) {
-          res.insert(n_parent->second.lock());
+      if (const auto& n_parent = _in_adjacent.find(node->Id());
+          n_parent != _in_adjacent.end()) {
+        for (const auto& i : n_parent->second) {
+          res.insert(i.second.lock());
         }
       }
     }
@@ -434,14 +691,14 @@ public:
   virtual std::unordered_set<
       EdgePtr, std::function<std::size_t(const EdgePtr&)>,
       std::function<bool(const EdgePtr&, const EdgePtr&)>>
-  InEdges(const std::string& name) const {
+  InEdges(const std::string_view name) const {
     decltype(_edges) res(1, _edges.hash_function(), _edges.key_eq());
 
     if (const auto node = GetNode(name)) {
-      for (const auto& i : _adjacent) {
-        if (const auto& n_parent = i.second.find(node->Id());
-            n_parent != i.second.end()) {
-          res.insert(n_parent->second.lock());
+      if (const auto& n_parent = _in_adjacent.find(node->Id());
+          n_parent != _in_adjacent.end()) {
+        for (const auto& i : n_parent->second) {
+          res.insert(i.second.lock());
         }
       }
     }
@@ -480,7 +737,7 @@ public:
   virtual std::unordered_set<
       EdgePtr, std::function<std::size_t(const EdgePtr&)>,
       std::function<bool(const EdgePtr&, const EdgePtr&)>>
-  OutEdges(const std::string& name) const {
+  OutEdges(const std::string_view name) const {
     decltype(_edges) res(1, _edges.hash_function(), _edges.key_eq());
 
     if (const auto node = GetNode(name)) {
@@ -499,7 +756,7 @@ public:
    * @brief Get size of all edges
    * @return Size of edges
    */
-  [[nodiscard]] virtual std::size_t EdgeSize() const { return Edges().size(); }
+  [[nodiscard]] virtual std::size_t EdgeSize() const { return _edges.size(); }
 
   /*!
    * @brief Get size of edges bind to the node
@@ -508,7 +765,7 @@ public:
    * @return Size of edges bind to the node
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
   [[nodiscard]] std::size_t EdgeSize(T&& n) const {
     return Edges(std::forward<T>(n)).size();
@@ -521,7 +778,7 @@ public:
    * @return Size of in edges
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
   [[nodiscard]] std::size_t InEdgeSize(T&& n) const {
     return InEdges(std::forward<T>(n)).size();
@@ -534,7 +791,7 @@ public:
    * @return Size of out edges
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
   [[nodiscard]] std::size_t OutEdgeSize(T&& n) const {
     return OutEdges(std::forward<T>(n)).size();
@@ -549,15 +806,8 @@ public:
       NodePtr, std::function<std::size_t(const NodePtr&)>,
       std::function<bool(const NodePtr&, const NodePtr&)>>
   Parents(const std::size_t& id) const {
-    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
-
-    // Add parent nodes
-    for (const auto in_edges = DiGraph<Node, Edge>::InEdges(id);
-         const auto& i : in_edges) {
-      res.insert(i->Source());
-    }
-
-    return res;
+    return CachedQuery(Query::Parents, id,
+                       [this, &id] { return ComputeParents(id); });
   }
 
   /*!
@@ -568,16 +818,11 @@ public:
   virtual std::unordered_set<
       NodePtr, std::function<std::size_t(const NodePtr&)>,
       std::function<bool(const NodePtr&, const NodePtr&)>>
-  Parents(const std::string& name) const {
-    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
-
-    // Add parent nodes
-    for (const auto in_edges = DiGraph<Node, Edge>::InEdges(name);
-         const auto& i : in_edges) {
-      res.insert(i->Source());
+  Parents(const std::string_view name) const {
+    if (const auto node = GetNode(name)) {
+      return DiGraph<Node, Edge>::Parents(node->Id());
     }
-
-    return res;
+    return decltype(_nodes)(1, _nodes.hash_function(), _nodes.key_eq());
   }
 
   /*!
@@ -589,15 +834,8 @@ public:
       NodePtr, std::function<std::size_t(const NodePtr&)>,
       std::function<bool(const NodePtr&, const NodePtr&)>>
   Children(const std::size_t& id) const {
-    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
-
-    // Add child nodes
-    for (const auto& out_edges = DiGraph<Node, Edge>::OutEdges(id);
-         const auto& i : out_edges) {
-      res.insert(i->Target());
-    }
-
-    return res;
+    return CachedQuery(Query::Children, id,
+                       [this, &id] { return ComputeChildren(id); });
   }
 
   /*!
@@ -608,16 +846,11 @@ public:
   virtual std::unordered_set<
       NodePtr, std::function<std::size_t(const NodePtr&)>,
       std::function<bool(const NodePtr&, const NodePtr&)>>
-  Children(const std::string& name) const {
-    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
-
-    // Add child nodes
-    for (const auto& out_edges = DiGraph<Node, Edge>::OutEdges(name);
-         const auto& i : out_edges) {
-      res.insert(i->Target());
+  Children(const std::string_view name) const {
+    if (const auto node = GetNode(name)) {
+      return DiGraph<Node, Edge>::Children(node->Id());
     }
-
-    return res;
+    return decltype(_nodes)(1, _nodes.hash_function(), _nodes.key_eq());
   }
 
   /*!
@@ -629,31 +862,33 @@ public:
       NodePtr, std::function<std::size_t(const NodePtr&)>,
       std::function<bool(const NodePtr&, const NodePtr&)>>
   Predecessor(const std::size_t& id) const {
-    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
-
-    // Initialize the queue
-    auto first_parents = DiGraph<Node, Edge>::Parents(id);
-    res.merge(first_parents);
+    return CachedQuery(Query::Predecessor, id, [this, &id] {
+      decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
 
-    std::queue<NodePtr> q(first_parents.cbegin(), first_parents.cend());
+      // Initialize the queue
+      // Steps of the walk bypass the cache, only its result is kept
+      auto first_parents = ComputeParents(id);
+      std::queue<NodePtr> q(first_parents.cbegin(), first_parents.cend());
+      res.merge(first_parents);
 
-    // Add predecessor in a FIFO manner
-    while (!q.empty()) {
-      const auto n = q.front();
+      // Add predecessor in a FIFO manner
+      while (!q.empty()) {
+        const auto n = q.front();
 
-      auto n_parents = DiGraph<Node, Edge>::Parents(n->Id());
+        auto n_parents = ComputeParents(n->Id());
 
-      for (auto& p : n_parents) {
-        if (!res.contains(p)) {
-          q.push(p);
+        for (auto& p : n_parents) {
+          if (!res.contains(p)) {
+            q.push(p);
+          }
         }
-      }
 
-      res.merge(n_parents);
-      q.pop();
-    }
+        res.merge(n_parents);
+        q.pop();
+      }
 
-    return res;
+      return res;
+    });
   }
 
   /*!
@@ -664,32 +899,11 @@ public:
   virtual std::unordered_set<
       NodePtr, std::function<std::size_t(const NodePtr&)>,
       std::function<bool(const NodePtr&, const NodePtr&)>>
-  Predecessor(const std::string& name) const {
-    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
-
-    // Initialize the queue
-    auto first_parents = DiGraph<Node, Edge>::Parents(name);
-    res.merge(first_parents);
-
-    std::queue<NodePtr> q(first_parents.cbegin(), first_parents.cend());
-
-    // Add predecessor in a FIFO manner
-    while (!q.empty()) {
-      const auto n = q.front();
-
-      auto n_parents = DiGraph<Node, Edge>::Parents(n->Name());
-
-      for (auto& p : n_parents) {
-        if (!res.contains(p)) {
-          q.push(p);
-        }
-      }
-
-      res.merge(n_parents);
-      q.pop();
+  Predecessor(const std::string_view name) const {
+    if (const auto node = GetNode(name)) {
+      return DiGraph<Node, Edge>::Predecessor(node->Id());
     }
-
-    return res;
+    return decltype(_nodes)(1, _nodes.hash_function(), _nodes.key_eq());
   }
 
   /*!
@@ -701,31 +915,33 @@ public:
       NodePtr, std::function<std::size_t(const NodePtr&)>,
       std::function<bool(const NodePtr&, const NodePtr&)>>
   Successor(const std::size_t& id) const {
-    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
+    return CachedQuery(Query::Successor, id, [this, &id] {
+      decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
 
-    // Initialize the queue
-    auto first_children = DiGraph<Node, Edge>::Children(id);
-    res.merge(first_children);
+      // Initialize the queue
+      // Steps of the walk bypass the cache, only its result is kept
+      auto first_children = ComputeChildren(id);
+      std::queue<NodePtr> q(first_children.cbegin(), first_children.cend());
+      res.merge(first_children);
 
-    std::queue<NodePtr> q(first_children.cbegin(), first_children.cend());
+      // Add successor in a FIFO manner
+      while (!q.empty()) {
+        const auto n = q.front();
 
-    // Add successor in a FIFO manner
-    while (!q.empty()) {
-      const auto n = q.front();
+        auto n_children = ComputeChildren(n->Id());
 
-      auto n_children = DiGraph<Node, Edge>::Children(n->Id());
-
-      for (auto& p : n_children) {
-        if (!res.contains(p)) {
-          q.push(p);
+        for (auto& p : n_children) {
+          if (!res.contains(p)) {
+            q.push(p);
+          }
         }
-      }
 
-      res.merge(n_children);
-      q.pop();
-    }
+        res.merge(n_children);
+        q.pop();
+      }
 
-    return res;
+      return res;
+    });
   }
 
   /*!
@@ -736,32 +952,11 @@ public:
   virtual std::unordered_set<
       NodePtr, std::function<std::size_t(const NodePtr&)>,
       std::function<bool(const NodePtr&, const NodePtr&)>>
-  Successor(const std::string& name) const {
-    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
-
-    // Initialize the queue
-    auto first_children = DiGraph<Node, Edge>::Children(name);
-    res.merge(first_children);
-
-    std::queue<NodePtr> q(first_children.cbegin(), first_children.cend());
-
-    // Add successor in a FIFO manner
-    while (!q.empty()) {
-      const auto n = q.front();
-
-      auto n_children = DiGraph<Node, Edge>::Children(n->Name());
-
-      for (auto& p : n_children) {
-        if (!res.contains(p)) {
-          q.push(p);
-        }
-      }
-
-      res.merge(n_children);
-      q.pop();
+  Successor(const std::string_view name) const {
+    if (const auto node = GetNode(name)) {
+      return DiGraph<Node, Edge>::Successor(node->Id());
     }
-
-    return res;
+    return decltype(_nodes)(1, _nodes.hash_function(), _nodes.key_eq());
   }
 
   /*!
@@ -771,7 +966,7 @@ public:
    * @return Lineage
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
   auto NodeLineage(T&& n) const {
     auto res = DiGraph<Node, Edge>::Predecessor(std::forward<T>(n));
@@ -787,7 +982,7 @@ public:
    * @return Neighbors
    */
   template <typename T>
-    requires(std::convertible_to<T, std::string> ||
+    requires(std::convertible_to<T, std::string_view> ||
              std::convertible_to<T, std::size_t>)
   auto Neighbors(T&& n) const {
     auto res = DiGraph<Node, Edge>::Parents(std::forward<T>(n));
@@ -797,6 +992,194 @@ public:
   }
 
 private:
+  //! @brief Kind of cached query
+  enum class Query : std::uint8_t { Parents, Children, Predecessor, Successor };
+
+  //! @brief Cache key (query, node id)
+  using QueryKey = std::pair<Query, std::size_t>;
+
+  //! @brief Hash function of cache key
+  struct QueryKeyHash {
+    std::size_t operator()(const QueryKey& key) const {
+      return key.second << 2 ^ static_cast<std::size_t>(key.first);
+    }
+  };
+
+  //! @brief Source and target ids of an edge
+  using ArcKey = std::pair<std::size_t, std::size_t>;
+
+  //! @brief Hash function of arc key
+  struct ArcKeyHash {
+    std::size_t operator()(const ArcKey& key) const {
+      return key.first * 0x9e3779b97f4a7c15 ^ key.second;
+    }
+  };
+
+  using QueryCache = utils::LRUCache<
+      QueryKey,
+      std::unordered_set<NodePtr, NodePtrHash_t<Node>, NodePtrEqual_t<Node>>,
+      QueryKeyHash>;
+
+  /*!
+   * @brief Resolve node id without allocation
+   * @tparam T Argument type that can convert to string_view or size_t
+   * @param n Node id or name
+   * @return Node id, nullopt if the name is unknown
+   */
+  template <typename T>
+  std::optional<std::size_t> NodeId(T&& n) const {
+    if constexpr (std::convertible_to<T, std::size_t>) {
+      return static_cast<std::size_t>(n);
+    } else {
+      if (const auto node = GetNode(std::string_view(n))) {
+        return node->Id();
+      }
+      return std::nullopt;
+    }
+  }
+
+  /*!
+   * @brief Get the edge linked in the adjacency row
+   * @param s_id Source node id
+   * @param t_id Target node id
+   * @param w Weight filter
+   * @param linked Set if an edge is linked whatever its weight
+   * @return Edge ptr if linked with matching weight else nullptr
+   */
+  EdgePtr FindLinked(const std::size_t s_id, const std::size_t t_id,
+                     const std::optional<WeightArg>& w, bool& linked) const {
+    if (const auto row = _adjacent.find(s_id); row != _adjacent.end()) {
+      if (const auto entry = row->second.find(t_id);
+          entry != row->second.end()) {
+        auto e = entry->second.lock();
+        linked = true;
+        if (IsUnweighted_v<Edge> || !w || e->Weight() == *w) {
+          return e;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  /*!
+   * @brief Drop the adjacency entry of an edge if it refers to this edge,
+   * linking the last shadowed parallel edge in its place if there is one
+   * @param e Stored edge ptr, still in `_edges`
+   */
+  void Unlink(const EdgePtr& e) {
+    const auto s_id = e->Source()->Id();
+    const auto t_id = e->Target()->Id();
+    const auto bucket = _parallel.find({s_id, t_id});
+    const auto row = _adjacent.find(s_id);
+    const auto entry = row != _adjacent.end() ? row->second.find(t_id)
+                                              : typename NodeAdj::iterator{};
+    if (row == _adjacent.end() || entry == row->second.end() ||
+        entry->second.lock() != e) {
+      // Not linked, so shadowed by a parallel edge
+      if (bucket != _parallel.end()) {
+        std::erase_if(bucket->second, [&e](const std::weak_ptr<Edge>& other) {
+          return other.lock() == e;
+        });
+        if (bucket->second.empty()) {
+          _parallel.erase(bucket);
+        }
+      }
+      return;
+    }
+
+    if (bucket != _parallel.end()) {
+      entry->second = std::move(bucket->second.back());
+      _in_adjacent[t_id][s_id] = entry->second;
+      bucket->second.pop_back();
+      if (bucket->second.empty()) {
+        _parallel.erase(bucket);
+      }
+      return;
+    }
+
+    row->second.erase(entry);
+    if (const auto in_row = _in_adjacent.find(t_id);
+        in_row != _in_adjacent.end()) {
+      in_row->second.erase(s_id);
+    }
+  }
+
+  /*!
+   * @brief Link an edge in the out row of its source and the in row of its
+   * target, shadowing the parallel edge linked before
+   * @param e Stored edge ptr
+   */
+  void Link(const EdgePtr& e) {
+    const auto s_id = e->Source()->Id();
+    const auto t_id = e->Target()->Id();
+    auto& entry = _adjacent[s_id][t_id];
+    if (!entry.expired()) {
+      _parallel[{s_id, t_id}].push_back(std::move(entry));
+    }
+    entry = std::weak_ptr<Edge>(e);
+    _in_adjacent[t_id][s_id] = std::weak_ptr<Edge>(e);
+  }
+
+  static void EraseEmptyRow(std::unordered_map<std::size_t, NodeAdj>& rows,
+                            const std::size_t id) {
+    if (const auto row = rows.find(id);
+        row != rows.end() && row->second.empty()) {
+      rows.erase(row);
+    }
+  }
+
+  /*!
+   * @brief Parents of the node without the cache
+   * @param id Node id
+   * @return Parents nodes
+   */
+  std::unordered_set<NodePtr, NodePtrHash_t<Node>, NodePtrEqual_t<Node>>
+  ComputeParents(const std::size_t id) const {
+    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
+    for (const auto in_edges = DiGraph<Node, Edge>::InEdges(id);
+         const auto& i : in_edges) {
+      res.insert(i->Source());
+    }
+    return res;
+  }
+
+  /*!
+   * @brief Children of the node without the cache
+   * @param id Node id
+   * @return Children nodes
+   */
+  std::unordered_set<NodePtr, NodePtrHash_t<Node>, NodePtrEqual_t<Node>>
+  ComputeChildren(const std::size_t id) const {
+    decltype(_nodes) res(1, _nodes.hash_function(), _nodes.key_eq());
+    for (const auto& out_edges = DiGraph<Node, Edge>::OutEdges(id);
+         const auto& i : out_edges) {
+      res.insert(i->Target());
+    }
+    return res;
+  }
+
+  /*!
+   * @brief Answer query from the cache if enabled
+   * @tparam Func Callable computing the query
+   * @param query Kind of query
+   * @param id Node id
+   * @param compute Function computing the query on cache miss
+   * @return Query result
+   */
+  template <typename Func>
+  std::unordered_set<NodePtr, NodePtrHash_t<Node>, NodePtrEqual_t<Node>>
+  CachedQuery(const Query query, const std::size_t id, Func&& compute) const {
+    if (!_query_cache) {
+      return compute();
+    }
+
+    _query_cache->Validate(_version);
+    if (const auto* res = _query_cache->Get({query, id}); res != nullptr) {
+      return *res;
+    }
+    return _query_cache->Put({query, id}, compute());
+  }
+
   //! @brief Nodes owner
   std::unordered_set<NodePtr, NodePtrHash_t<Node>, NodePtrEqual_t<Node>> _nodes;
 
@@ -806,8 +1189,33 @@ private:
   //! @brief Adjacent
   std::unordered_map<std::size_t, NodeAdj> _adjacent;
 
-  //! @brief Node name mapping
-  std::unordered_map<std::string, std::weak_ptr<Node>> _node_name;
+  //! @brief Reverse adjacent (target to sources)
+  std::unordered_map<std::size_t, NodeAdj> _in_adjacent;
+
+  //! @brief Dense node slots, nullptr for removed nodes
+  std::vector<NodePtr> _slots;
+
+  //! @brief Node id to slot
+  std::unordered_map<std::size_t, std::size_t> _slot_of;
+
+  //! @brief Size of removed slots not reclaimed yet
+  std::size_t _tombstones{0};
+
+  //! @brief Edges hidden from the rows by a parallel edge, by (source,
+  //! target), the last one is linked next
+  std::unordered_map<ArcKey, std::vector<std::weak_ptr<Edge>>, ArcKeyHash>
+      _parallel;
+
+  //! @brief Node name mapping (keys view the names of stored nodes)
+  std::unordered_map<NodeNameKey_t<Node>, std::weak_ptr<Node>,
+                     utils::StringHash, std::equal_to<>>
+      _node_name;
+
+  //! @brief Modification counter
+  std::size_t _version{0};
+
+  //! @brief Optional cache of derived query results
+  mutable std::unique_ptr<QueryCache> _query_cache;
 };
 
 /*!
@@ -858,7 +1266,7 @@ public:
    */
   std::unordered_set<EdgePtr, std::function<std::size_t(const EdgePtr&)>,
                      std::function<bool(const EdgePtr&, const EdgePtr&)>>
-  InEdges(const std::string& name) const override {
+  InEdges(const std::string_view name) const override {
     return DiGraph<Node, Edge>::Edges(name);
   }
 
@@ -880,7 +1288,7 @@ public:
    */
   std::unordered_set<EdgePtr, std::function<std::size_t(const EdgePtr&)>,
                      std::function<bool(const EdgePtr&, const EdgePtr&)>>
-  OutEdges(const std::string& name) const override {
+  OutEdges(const std::string_view name) const override {
     return DiGraph<Node, Edge>::Edges(name);
   }
 
@@ -902,7 +1310,7 @@ public:
    */
   std::unordered_set<NodePtr, std::function<std::size_t(const NodePtr&)>,
                      std::function<bool(const NodePtr&, const NodePtr&)>>
-  Parents(const std::string& name) const override {
+  Parents(const std::string_view name) const override {
     return DiGraph<Node, Edge>::Neighbors(name);
   }
 
@@ -924,7 +1332,7 @@ public:
    */
   std::unordered_set<NodePtr, std::function<std::size_t(const NodePtr&)>,
                      std::function<bool(const NodePtr&, const NodePtr&)>>
-  Children(const std::string& name) const override {
+  Children(const std::string_view name) const override {
     return DiGraph<Node, Edge>::Neighbors(name);
   }
 
@@ -946,7 +1354,7 @@ public:
    */
   std::unordered_set<NodePtr, std::function<std::size_t(const NodePtr&)>,
                      std::function<bool(const NodePtr&, const NodePtr&)>>
-  Predecessor(const std::string& name) const override {
+  Predecessor(const std::string_view name) const override {
     return DiGraph<Node, Edge>::NodeLineage(name);
   }
 
@@ -968,7 +1376,7 @@ public:
    */
   std::unordered_set<NodePtr, std::function<std::size_t(const NodePtr&)>,
                      std::function<bool(const NodePtr&, const NodePtr&)>>
-  Successor(const std::string& name) const override {
+  Successor(const std::string_view name) const override {
     return DiGraph<Node, Edge>::NodeLineage(name);
   }
 };
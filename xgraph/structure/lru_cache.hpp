@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace xgraph::utils {
+
+/*!
+ * @brief Counters of a cache
+ */
+struct CacheStats {
+  //! @brief Lookups answered by the cache
+  std::size_t hits{0};
+
+  //! @brief Lookups that had to be computed
+  std::size_t misses{0};
+
+  //! @brief Entries dropped because the cache was full
+  std::size_t evictions{0};
+
+  //! @brief Times the whole cache was dropped because the source changed
+  std::size_t invalidations{0};
+};
+
+/*!
+ * @brief Bounded least-recently-used cache tagged with a source version
+ *
+ * All entries belong to one version of their source, `Validate` drops them
+ * as soon as a different version is observed.
+ *
+ * @tparam Key Key type
+ * @tparam Value Value type
+ * @tparam Hash Hash function of key
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache {
+public:
+  /*!
+   * @brief Constructor
+   * @param capacity Max number of entries (at least one)
+   */
+  explicit LRUCache(const std::size_t capacity)
+      : _capacity(capacity == 0 ? 1 : capacity) {}
+
+  /*!
+   * @brief Drop all entries if the source version changed
+   * @param version Current version of the source
+   */
+  void Validate(const std::size_t version) {
+    if (version != _version) {
+      if (!_entries.empty()) {
+        ++_stats.invalidations;
+      }
+      Clear();
+      _version = version;
+    }
+  }
+
+  /*!
+   * @brief Lookup an entry and mark it as most recently used
+   * @param key Key
+   * @return Pointer to value if cached else nullptr
+   */
+  const Value* Get(const Key& key) {
+    const auto it = _index.find(key);
+    if (it == _index.end()) {
+      ++_stats.misses;
+      return nullptr;
+    }
+
+    ++_stats.hits;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return &it->second->second;
+  }
+
+  /*!
+   * @brief Insert or replace an entry, evicting the least recently used one
+   * if full
+   * @param key Key
+   * @param value Value
+   * @return Reference to the cached value
+   */
+  const Value& Put(const Key& key, Value value) {
+    if (const auto it = _index.find(key); it != _index.end()) {
+      it->second->second = std::move(value);
+      _entries.splice(_entries.begin(), _entries, it->second);
+      return it->second->second;
+    }
+
+    if (_entries.size() >= _capacity) {
+      _index.erase(_entries.back().first);
+      _entries.pop_back();
+      ++_stats.evictions;
+    }
+
+    _entries.emplace_front(key, std::move(value));
+    _index.emplace(key, _entries.begin());
+    return _entries.front().second;
+  }
+
+  /*!
+   * @brief Drop all entries (counters are kept)
+   */
+  void Clear() {
+    _index.clear();
+    _entries.clear();
+  }
+
+  /*!
+   * @brief Get size of cached entries
+   * @return Size of entries
+   */
+  [[nodiscard]] std::size_t Size() const { return _entries.size(); }
+
+  /*!
+   * @brief Get max number of entries
+   * @return Capacity
+   */
+  [[nodiscard]] std::size_t Capacity() const { return _capacity; }
+
+  /*!
+   * @brief Get counters
+   * @return Counters
+   */
+  [[nodiscard]] const CacheStats& Stats() const { return _stats; }
+
+private:
+  //! @brief Max number of entries
+  std::size_t _capacity;
+
+  //! @brief Version of the source the entries belong to
+  std::size_t _version{0};
+
+  //! @brief Entries from most to least recently used
+  std::list<std::pair<Key, Value>> _entries;
+
+  //! @brief Key to entry
+  std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator,
+                     Hash>
+      _index;
+
+  //! @brief Counters
+  CacheStats _stats;
+};
+
+} // namespace xgraph::utils
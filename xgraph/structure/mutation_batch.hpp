@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "edge.hpp"
+#include "node.hpp"
+#include "type_traits.hpp"
+
+namespace xgraph {
+
+/*!
+ * @brief Buffer of edge additions and removals applied to a graph at once
+ *
+ * Mutations are only recorded, `DiGraph::Apply` normalizes them (the last
+ * mutation of an edge overrides the earlier ones, so opposite operations
+ * cancel out) and applies them grouped by source node in a single pass.
+ * Edges are identified by (source id, target id, weight) like in `DiGraph`.
+ *
+ * @tparam Node Node class that satisfy `NodeType` concept
+ * @tparam Edge Edge class that satisfy `EdgeType` concept
+ */
+template <NodeType Node = XNode<>, EdgeType Edge = XEdge<>>
+class MutationBatch {
+  using EdgePtr = std::shared_ptr<Edge>;
+  using WeightArg = EdgeWeightArg_t<Edge>;
+
+public:
+  //! @brief Kind of mutation
+  enum class Kind : std::uint8_t { Add, Remove };
+
+  //! @brief One buffered mutation
+  struct Mutation {
+    //! @brief Kind of mutation
+    Kind kind;
+
+    //! @brief Source node id
+    std::size_t source;
+
+    //! @brief Target node id
+    std::size_t target;
+
+    //! @brief Edge weight (ignored by unweighted edges)
+    WeightArg weight;
+
+    //! @brief Edge to add (nullptr to construct it from the fields above)
+    EdgePtr edge;
+  };
+
+  /*!
+   * @brief Buffer adding an edge ptr
+   * @param e Edge ptr
+   */
+  void AddEdge(const EdgePtr& e) {
+    _mutations.push_back(
+        {Kind::Add, e->Source()->Id(), e->Target()->Id(), e->Weight(), e});
+  }
+
+  /*!
+   * @brief Buffer adding an edge
+   * @param s_id Source node id
+   * @param t_id Target node id
+   * @param w Weight
+   */
+  void AddEdge(const std::size_t& s_id, const std::size_t& t_id,
+               const WeightArg w = WeightArg{1}) {
+    _mutations.push_back({Kind::Add, s_id, t_id, w, nullptr});
+  }
+
+  /*!
+   * @brief Buffer removing an edge
+   * @param e Edge ptr
+   */
+  void RemoveEdge(const EdgePtr& e) {
+    RemoveEdge(e->Source()->Id(), e->Target()->Id(), e->Weight());
+  }
+
+  /*!
+   * @brief Buffer removing an edge
+   * @param s_id Source node id
+   * @param t_id Target node id
+   * @param w Weight
+   */
+  void RemoveEdge(const std::size_t& s_id, const std::size_t& t_id,
+                  const WeightArg w = WeightArg{1}) {
+    _mutations.push_back({Kind::Remove, s_id, t_id, w, nullptr});
+  }
+
+  /*!
+   * @brief Get size of buffered mutations
+   * @return Size of mutations
+   */
+  [[nodiscard]] std::size_t Size() const { return _mutations.size(); }
+
+  /*!
+   * @brief Whether nothing is buffered
+   * @return Boolean
+   */
+  [[nodiscard]] bool Empty() const { return _mutations.empty(); }
+
+  /*!
+   * @brief Drop all buffered mutations
+   */
+  void Clear() { _mutations.clear(); }
+
+  /*!
+   * @brief Sort mutations by edge and keep only the last one of every edge
+   * @param directed Whether (s, t) and (t, s) are different edges
+   * @return Normalized mutations ordered by source
+   */
+  const std::vector<Mutation>& Normalize(const bool directed) {
+    const auto key = [directed](const Mutation& m) {
+      const auto w = IsUnweighted_v<Edge> ? WeightArg{1} : m.weight;
+      if (directed || m.source <= m.target) {
+        return std::tuple(m.source, m.target, w);
+      }
+      return std::tuple(m.target, m.source, w);
+    };
+
+    // Stable sort keeps the buffered order inside every edge
+    std::ranges::stable_sort(_mutations, {}, key);
+
+    std::size_t size{0};
+    for (std::size_t i = 0; i < _mutations.size(); ++i) {
+      if (i + 1 < _mutations.size() &&
+          key(_mutations[i]) == key(_mutations[i + 1])) {
+        continue;
+      }
+      if (size != i) {
+        _mutations[size] = std::move(_mutations[i]);
+      }
+      ++size;
+    }
+    _mutations.resize(size);
+
+    return _mutations;
+  }
+
+private:
+  //! @brief Buffered mutations
+  std::vector<Mutation> _mutations;
+};
+
+} // namespace xgraph
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "type_concepts.hpp"
@@ -130,15 +131,15 @@ public:
 
   /*!
    * @brief Get const node name
-   * @return Node name
+   * @return View of node name, valid as long as the node
    */
-  [[nodiscard]] std::string Name() const { return _name; }
+  [[nodiscard]] std::string_view Name() const { return _name; }
 
   /*!
-   * @brief Get const node data
+   * @brief Get const reference to node data
    * @return Node data
    */
-  NodeData Data() const { return _node_data; }
+  const NodeData& Data() const { return _node_data; }
 
   /*!
    * @brief Get reference to node data
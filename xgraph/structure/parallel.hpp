@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace xgraph::utils {
+
+/*!
+ * @brief Resolve a requested number of worker threads
+ * @param threads Requested number (0 for the hardware concurrency)
+ * @return Number of workers, at least 1
+ */
+inline std::size_t WorkerCount(const std::size_t threads) {
+  if (threads != 0) {
+    return threads;
+  }
+  return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+/*!
+ * @brief Run `func(worker, index)` for every index in `[0, size)`
+ *
+ * Indices are handed out one by one from a shared counter, so uneven tasks
+ * balance themselves. `worker` is in `[0, WorkerCount(threads))` and is never
+ * used by two threads at once, which lets callers keep per-worker state. The
+ * calling thread is the only worker when one is enough.
+ *
+ * @param size Size of indices
+ * @param threads Requested number of workers (0 for the hardware concurrency)
+ * @param func Callable on (worker, index)
+ * @throw The first exception thrown by `func`, once all workers stopped
+ */
+template <typename Func>
+void ParallelFor(const std::size_t size, const std::size_t threads,
+                 Func&& func) {
+  const auto workers = std::min(WorkerCount(threads), size);
+  if (workers <= 1) {
+    for (std::size_t i = 0; i < size; ++i) {
+      func(std::size_t{0}, i);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  {
+    std::vector<std::jthread> pool;
+    pool.reserve(workers);
+    for (std::size_t w = 0; w < workers; ++w) {
+      pool.emplace_back([&, w] {
+        try {
+          for (auto i = next.fetch_add(1); i < size; i = next.fetch_add(1)) {
+            func(w, i);
+          }
+        } catch (...) {
+          const std::lock_guard lock(error_mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+          next = size;
+        }
+      });
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/*!
+ * @brief Worker threads kept alive across parallel loops
+ *
+ * `ParallelFor` starts its threads on every call, which dominates algorithms
+ * running many short rounds. A pool starts them once, idle workers wait on a
+ * barrier between rounds. The calling thread is worker 0.
+ */
+class WorkerPool {
+public:
+  /*!
+   * @brief Constructor, starts the workers
+   * @param threads Number of workers (0 for the hardware concurrency)
+   */
+  explicit WorkerPool(const std::size_t threads = 0)
+      : _size(WorkerCount(threads)),
+        _barrier(static_cast<std::ptrdiff_t>(_size)) {
+    _threads.reserve(_size - 1);
+    for (std::size_t w = 1; w < _size; ++w) {
+      _threads.emplace_back([this, w] {
+        while (true) {
+          _barrier.arrive_and_wait();
+          if (_stop) {
+            return;
+          }
+          Work(w);
+          _barrier.arrive_and_wait();
+        }
+      });
+    }
+  }
+
+  WorkerPool(const WorkerPool& other) = delete;
+
+  WorkerPool& operator=(const WorkerPool& other) = delete;
+
+  /*!
+   * @brief Destructor, stops and joins the workers
+   */
+  ~WorkerPool() {
+    if (_size > 1) {
+      _stop = true;
+      _barrier.arrive_and_wait();
+    }
+  }
+
+  /*!
+   * @brief Get number of workers
+   * @return Number of workers, the calling thread included
+   */
+  [[nodiscard]] std::size_t Size() const { return _size; }
+
+  /*!
+   * @brief Run `func(worker, index)` for every index in `[0, size)`, like
+   * `utils::ParallelFor`
+   * @note Not reentrant, one loop runs at a time
+   * @param size Size of indices
+   * @param func Callable on (worker, index)
+   * @throw The first exception thrown by `func`, once all workers stopped
+   */
+  template <typename Func>
+  void ParallelFor(const std::size_t size, Func&& func) {
+    if (_size <= 1 || size <= 1) {
+      for (std::size_t i = 0; i < size; ++i) {
+        func(std::size_t{0}, i);
+      }
+      return;
+    }
+
+    _task = [&func](const std::size_t w, const std::size_t i) { func(w, i); };
+    _round_size = size;
+    _next = 0;
+    _barrier.arrive_and_wait();
+    Work(0);
+    _barrier.arrive_and_wait();
+    _task = nullptr;
+    if (_error) {
+      std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+  }
+
+private:
+  void Work(const std::size_t w) {
+    try {
+      for (auto i = _next.fetch_add(1); i < _round_size;
+           i = _next.fetch_add(1)) {
+        _task(w, i);
+      }
+    } catch (...) {
+      const std::lock_guard lock(_error_mutex);
+      if (!_error) {
+        _error = std::current_exception();
+      }
+      _next = _round_size;
+    }
+  }
+
+  //! @brief Number of workers
+  std::size_t _size;
+
+  //! @brief Separates rounds, every worker arrives at their start and end
+  std::barrier<> _barrier;
+
+  //! @brief Set to stop the workers
+  bool _stop{false};
+
+  //! @brief Body of the current round
+  std::function<void(std::size_t, std::size_t)> _task;
+
+  //! @brief Size of indices of the current round
+  std::size_t _round_size{0};
+
+  //! @brief Next index to hand out
+  std::atomic<std::size_t> _next{0};
+
+  //! @brief First exception of the current round
+  std::exception_ptr _error;
+
+  //! @brief Guards `_error`
+  std::mutex _error_mutex;
+
+  //! @brief Worker threads other than the caller, joined first
+  std::vector<std::jthread> _threads;
+};
+
+} // namespace xgraph::utils
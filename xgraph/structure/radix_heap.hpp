@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace xgraph::utils {
+
+/*!
+ * @brief Monotone priority queue of unsigned integer keys
+ *
+ * Entries are bucketed by the highest bit in which their key differs from the
+ * last popped key, so push is O(1) and every entry is moved at most once per
+ * bit of the key. Keys pushed must not be smaller than the last popped key,
+ * which holds for Dijkstra with non-negative integer weights.
+ *
+ * @tparam Value Value type
+ */
+template <typename Value> class RadixHeap {
+public:
+  /*!
+   * @brief Push an entry
+   * @param key Key, not smaller than the last popped one
+   * @param value Value
+   */
+  void Push(const std::uint64_t key, Value value) {
+    _buckets[Bucket(key)].emplace_back(key, std::move(value));
+    ++_size;
+  }
+
+  /*!
+   * @brief Pop an entry with the minimal key
+   * @return Key and value
+   */
+  std::pair<std::uint64_t, Value> Pop() {
+    if (_buckets[0].empty()) {
+      // Redistribute the first non empty bucket around its minimal key
+      std::size_t i{1};
+      while (_buckets[i].empty()) {
+        ++i;
+      }
+
+      _last = std::numeric_limits<std::uint64_t>::max();
+      for (const auto& entry : _buckets[i]) {
+        _last = std::min(_last, entry.first);
+      }
+      for (auto& entry : _buckets[i]) {
+        _buckets[Bucket(entry.first)].push_back(std::move(entry));
+      }
+      _buckets[i].clear();
+    }
+
+    auto res = std::move(_buckets[0].back());
+    _buckets[0].pop_back();
+    --_size;
+    return res;
+  }
+
+  /*!
+   * @brief Whether there is no entry
+   * @return Boolean
+   */
+  [[nodiscard]] bool Empty() const { return _size == 0; }
+
+  /*!
+   * @brief Get size of entries
+   * @return Size of entries
+   */
+  [[nodiscard]] std::size_t Size() const { return _size; }
+
+private:
+  [[nodiscard]] std::size_t Bucket(const std::uint64_t key) const {
+    return static_cast<std::size_t>(std::bit_width(key ^ _last));
+  }
+
+  //! @brief Buckets by highest differing bit (0 for keys equal to `_last`)
+  std::array<std::vector<std::pair<std::uint64_t, Value>>, 65> _buckets;
+
+  //! @brief Last popped key
+  std::uint64_t _last{0};
+
+  //! @brief Size of entries
+  std::size_t _size{0};
+};
+
+} // namespace xgraph::utils
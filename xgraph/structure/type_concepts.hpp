@@ -1,6 +1,9 @@
 #pragma once
 
 #include <concepts>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
 
 namespace xgraph {
 
@@ -43,4 +46,35 @@ concept EdgeType = requires(T e) {
   { e.Weight() } -> std::convertible_to<double>;
 };
 
+/*!
+ * @brief Control value returned by traversal visitor hooks
+ */
+enum class VisitControl : std::uint8_t {
+  //! @brief Go on
+  Continue,
+  //! @brief Do not expand the node (or follow the edge) just visited
+  SkipChildren,
+  //! @brief End the traversal
+  Stop,
+};
+
+/*!
+ * @brief Concept specify traversal visitor, a callable on node ptr returning
+ * `VisitControl` or an object with any of the hooks `DiscoverNode(node)`,
+ * `ExamineEdge(edge)` and `FinishNode(node)` (returning `void` or
+ * `VisitControl`)
+ * @tparam V
+ * @tparam Node
+ * @tparam Edge
+ */
+template <typename V, typename Node, typename Edge>
+concept TraversalVisitor =
+    requires(V& v, const std::shared_ptr<Node>& n) {
+      { v(n) } -> std::same_as<VisitControl>;
+    } || requires(V& v, const std::shared_ptr<Node>& n) {
+      v.DiscoverNode(n);
+    } || requires(V& v, const std::shared_ptr<Edge>& e) {
+      v.ExamineEdge(e);
+    } || requires(V& v, const std::shared_ptr<Node>& n) { v.FinishNode(n); };
+
 } // namespace xgraph
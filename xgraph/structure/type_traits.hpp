@@ -2,6 +2,10 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include "type_concepts.hpp"
 
@@ -39,6 +43,56 @@ template <EdgeType Edge>
 using EdgePtrEqual_t = std::function<bool(const std::shared_ptr<Edge>&,
                                           const std::shared_ptr<Edge>&)>;
 
+/*!
+ * @brief Key type of name to node mapping, a view of the node's own name if
+ * `Name()` exposes stored characters else an owned copy
+ * @tparam Node Input node type
+ */
+template <NodeType Node>
+using NodeNameKey_t = std::conditional_t<
+    std::is_reference_v<decltype(std::declval<const Node&>().Name())> ||
+        std::is_same_v<decltype(std::declval<const Node&>().Name()),
+                       std::string_view>,
+    std::string_view, std::string>;
+
+namespace detail {
+
+template <typename Edge> struct EdgeWeight {
+  using type =
+      std::remove_cvref_t<decltype(std::declval<const Edge&>().Weight())>;
+};
+
+template <typename Edge>
+  requires requires { typename Edge::WeightType; }
+struct EdgeWeight<Edge> {
+  using type = typename Edge::WeightType;
+};
+
+} // namespace detail
+
+/*!
+ * @brief Weight type of edge, `void` for unweighted edges
+ * @tparam Edge Input edge type
+ */
+template <EdgeType Edge>
+using EdgeWeight_t = typename detail::EdgeWeight<Edge>::type;
+
+/*!
+ * @brief Whether edges carry no weight (every weight is 1)
+ * @tparam Edge Input edge type
+ */
+template <EdgeType Edge>
+inline constexpr bool IsUnweighted_v = std::is_void_v<EdgeWeight_t<Edge>>;
+
+/*!
+ * @brief Type of weight arguments of graph methods, unweighted edges take
+ * and ignore a `double`
+ * @tparam Edge Input edge type
+ */
+template <EdgeType Edge>
+using EdgeWeightArg_t =
+    std::conditional_t<IsUnweighted_v<Edge>, double, EdgeWeight_t<Edge>>;
+
 // Use for algorithm
 
 /*!
@@ -56,4 +110,11 @@ template <NodeType Node>
 using Heuristic_t = std::function<double(const std::shared_ptr<Node>&,
                                          const std::shared_ptr<Node>&)>;
 
+/*!
+ * @brief Type of (source, target) pair of a shortest path query
+ * @tparam Node Input node type
+ */
+template <NodeType Node>
+using PathQuery_t = std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>>;
+
 } // namespace xgraph
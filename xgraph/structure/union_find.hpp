@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace xgraph::utils {
+
+/*!
+ * @brief Disjoint sets of dense indices, safe to update from many threads
+ *
+ * Every operation is lock-free: roots are linked with a compare-and-swap of
+ * the parent of the larger root, and finds shorten paths by splitting with
+ * compare-and-swaps that may fail harmlessly. Indices only decrease along a
+ * path, so links never form a cycle.
+ */
+class ConcurrentUnionFind {
+public:
+  /*!
+   * @brief Constructor, every index in its own set
+   * @param size Size of indices
+   */
+  explicit ConcurrentUnionFind(const std::size_t size) : _parent(size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      _parent[i].store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /*!
+   * @brief Get size of indices
+   * @return Size of indices
+   */
+  [[nodiscard]] std::size_t Size() const { return _parent.size(); }
+
+  /*!
+   * @brief Find the root of the set of an index
+   * @param index Index
+   * @return Root index, up to date unless other threads unite concurrently
+   */
+  std::size_t Find(std::size_t index) {
+    auto parent = _parent[index].load(std::memory_order_acquire);
+    while (parent != index) {
+      const auto grandparent = _parent[parent].load(std::memory_order_acquire);
+      // A failed exchange must not clobber `parent`, the walk goes on from
+      // the loaded one either way
+      auto expected = parent;
+      _parent[index].compare_exchange_weak(expected, grandparent,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed);
+      index = parent;
+      parent = grandparent;
+    }
+    return index;
+  }
+
+  /*!
+   * @brief Merge the sets of two indices
+   * @param lhs Index
+   * @param rhs Index
+   * @return Whether the sets were disjoint, exactly one of concurrent calls
+   * joining the same two sets returns true
+   */
+  bool Unite(std::size_t lhs, std::size_t rhs) {
+    while (true) {
+      lhs = Find(lhs);
+      rhs = Find(rhs);
+      if (lhs == rhs) {
+        return false;
+      }
+      if (lhs < rhs) {
+        std::swap(lhs, rhs);
+      }
+      // Link the larger root under the smaller one, unless it is no longer
+      // a root
+      auto expected = lhs;
+      if (_parent[lhs].compare_exchange_strong(expected, rhs,
+                                               std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+  }
+
+  /*!
+   * @brief Whether two indices are in the same set
+   * @param lhs Index
+   * @param rhs Index
+   * @return Boolean
+   */
+  bool Same(std::size_t lhs, std::size_t rhs) {
+    while (true) {
+      lhs = Find(lhs);
+      rhs = Find(rhs);
+      if (lhs == rhs) {
+        return true;
+      }
+      // `lhs` may have been linked meanwhile
+      if (_parent[lhs].load(std::memory_order_acquire) == lhs) {
+        return false;
+      }
+    }
+  }
+
+private:
+  //! @brief Parent of every index, roots are their own parent
+  std::vector<std::atomic<std::size_t>> _parent;
+};
+
+} // namespace xgraph::utils
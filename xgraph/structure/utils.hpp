@@ -1,8 +1,10 @@
 #pragma once
 
 #include <iostream>
+#include <string_view>
 
 #include "edge.hpp"
+#include "type_traits.hpp"
 
 namespace xgraph::utils {
 
@@ -30,6 +32,18 @@ bool NodePtrEqual(const std::shared_ptr<Node>& lhs,
   return *lhs == *rhs;
 }
 
+/*!
+ * @brief Transparent hash function of names, lookups by `std::string_view`
+ * or string literal do not allocate
+ */
+struct StringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(const std::string_view name) const {
+    return std::hash<std::string_view>{}(name);
+  }
+};
+
 /*!
  * @brief Print node information
  * @tparam Node Input node type
@@ -41,6 +55,21 @@ void PrintNode(const Node& n, std::ostream& out = std::cout) {
   out << "Node : " << n.Name() << std::endl;
 }
 
+/*!
+ * @brief Hash value of edge weight (0 for unweighted edges)
+ * @tparam Edge Input edge type
+ * @param e Input edge ptr
+ * @return Weight hash value
+ */
+template <EdgeType Edge>
+std::size_t WeightHash([[maybe_unused]] const std::shared_ptr<Edge>& e) {
+  if constexpr (IsUnweighted_v<Edge>) {
+    return 0;
+  } else {
+    return std::hash<EdgeWeight_t<Edge>>{}(e->Weight());
+  }
+}
+
 /*!
  * @brief Hash function of edge ptr in digraph
  * @tparam Edge Input edge type
@@ -50,7 +79,7 @@ void PrintNode(const Node& n, std::ostream& out = std::cout) {
 template <EdgeType Edge>
 std::size_t DiEdgePtrHash(const std::shared_ptr<Edge>& e) {
   return NodePtrHash(e->Source()) << 2 ^ NodePtrHash(e->Target()) ^
-         std::hash<double>{}(e->Weight());
+         WeightHash(e);
 }
 
 /*!
@@ -75,7 +104,7 @@ bool DiEdgePtrEqual(const std::shared_ptr<Edge>& lhs,
 template <EdgeType Edge>
 std::size_t EdgePtrHash(const std::shared_ptr<Edge>& e) {
   return NodePtrHash(e->Source()) ^ NodePtrHash(e->Target()) ^
-         std::hash<double>{}(e->Weight());
+         WeightHash(e);
 }
 
 /*!
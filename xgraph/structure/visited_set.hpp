@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace xgraph::utils {
+
+/*!
+ * @brief Set of dense indices that is cleared in O(1)
+ *
+ * Every index holds the epoch in which it was inserted and `Reset` only
+ * starts a new epoch, so one set can be reused by many traversals without
+ * clearing or reallocating. Stamps are wiped only when the epoch counter
+ * wraps around.
+ */
+class VisitedSet {
+public:
+  /*!
+   * @brief Empty the set and make room for indices in `[0, size)`
+   * @param size Upper bound of indices
+   */
+  void Reset(const std::size_t size) {
+    if (_stamps.size() < size) {
+      _stamps.resize(size, 0);
+    }
+    if (++_epoch == 0) {
+      std::ranges::fill(_stamps, 0);
+      _epoch = 1;
+    }
+  }
+
+  /*!
+   * @brief Insert an index
+   * @param index Index in `[0, size)` of the last `Reset`
+   * @return Whether the index was not in the set
+   */
+  bool Insert(const std::size_t index) {
+    if (_stamps[index] == _epoch) {
+      return false;
+    }
+    _stamps[index] = _epoch;
+    return true;
+  }
+
+  /*!
+   * @brief Whether the index is in the set
+   * @param index Index in `[0, size)` of the last `Reset`
+   * @return Boolean
+   */
+  [[nodiscard]] bool Contains(const std::size_t index) const {
+    return _stamps[index] == _epoch;
+  }
+
+  /*!
+   * @brief Get size of indices the set can hold without growing
+   * @return Capacity
+   */
+  [[nodiscard]] std::size_t Capacity() const { return _stamps.size(); }
+
+private:
+  //! @brief Epoch of insertion of every index
+  std::vector<std::uint32_t> _stamps;
+
+  //! @brief Current epoch (0 is never current)
+  std::uint32_t _epoch{0};
+};
+
+} // namespace xgraph::utils